@@ -18,37 +18,109 @@
 //ʱж
 #define AT_IS_TIMEOUT(start, time) (at_get_ms() - (start) > (time))
 
-static LIST_HEAD(atlist);                        /*ͷ ----------------*/
+static at_reader_t   def_reader;                 /*Ĭ϶߳(at_thread) ----*/
+static unsigned char def_reader_ready;
 
 /*
- * @brief    ַ
+ * @brief    һ("\r\n"һύ)
+ * @param[in]   s    - 
+ * @param[in]   len  - 
  */
-static void put_string(at_obj_t *at, const char *s)
+static void tx_line(at_obj_t *at, const char *s, unsigned int len)
 {
-    while (*s != '\0')
-        at->cfg.write(s++, 1);
+    at_iovec_t iov[2] = {{s, len}, {"\r\n", 2}};
+    char buf[MAX_AT_CMD_LEN + 2];
+    at->stats.tx_bytes += len + 2;
+    if (at->cfg.writev != NULL) {
+        at->cfg.writev(iov, 2);
+    } else if (len + 2 <= sizeof(buf)) {
+        memcpy(buf, s, len);
+        memcpy(buf + len, "\r\n", 2);
+        at->cfg.write(buf, len + 2);
+    } else {
+        at->cfg.write(s, len);
+        at->cfg.write("\r\n", 2);
+    }
+}
+
+/*
+ * @brief    ʽݽ(ֱд)
+ */
+static void tx_sink(void *param, const void *buf, unsigned int len)
+{
+    at_obj_t *at = (at_obj_t *)param;
+    at->cfg.write(buf, len);
+    at->stats.tx_bytes += len;
 }
 
+/*
+ * @brief    ɢд(writevӿʱϲд, ʱֶд)
+ */
+static void tx_iov(at_obj_t *at, const at_iovec_t *iov, int cnt)
+{
+    char buf[MAX_AT_CMD_LEN + 2];
+    unsigned int len = 0;
+    int i;
+    for (i = 0; i < cnt; i++)
+        len += iov[i].len;
+    at->stats.tx_bytes += len;
+    if (at->cfg.writev != NULL) {
+        at->cfg.writev(iov, cnt);
+    } else if (len <= sizeof(buf)) {
+        for (len = 0, i = 0; i < cnt; len += iov[i++].len)
+            memcpy(buf + len, iov[i].base, iov[i].len);
+        at->cfg.write(buf, len);
+    } else {
+        for (i = 0; i < cnt; i++)
+            at->cfg.write(iov[i].base, iov[i].len);
+    }
+}
+
+/*
+ * @brief    ģһ(ʵʷ͵)
+ */
+static void tmpl_line(at_obj_t *at, const at_tmpl_t *t, const at_arg_t *args)
+{
+    at_iovec_t iov[AT_TMPL_IOV_MAX];
+    char num[AT_TMPL_NUM_SIZE];
+    int i, cnt = at_tmpl_render(t, args, iov, num);
+    tx_iov(at, iov, cnt);
+    at->cfg.debug("->\r\n");
+    for (i = 0; i < cnt - 1; i++)                     //һΪ"\r\n"
+        at->cfg.debug("%.*s", (int)iov[i].len, (const char *)iov[i].base);
+    at->cfg.debug("\r\n");
+}
 
 /*
  * @brief    ַ()
  */
 static void put_line(at_obj_t *at, const char *s)
 {
-    put_string(at, s);
-    put_string(at, "\r\n");    
+    tx_line(at, s, strlen(s));
     at->cfg.debug("->\r\n%s\r\n", s);
 }
 
-//ӡ
+/*
+ * @brief    ʽһ
+ * @details  MAX_AT_CMD_LEN + 2ֽڵķֿ黺д, Ȳ,
+ *           (з)һд.
+ */
 static void at_print(at_obj_t *at, const char *cmd, ...)
 {
-    va_list args;	
+    va_list args;
+    at_stream_t s;
+    char buf[MAX_AT_CMD_LEN + 2];
+    at_stream_init(&s, buf, sizeof(buf), tx_sink, at);
     va_start(args, cmd);
-    char buf[MAX_AT_CMD_LEN];
-    vsnprintf(buf, sizeof(buf), cmd, args);
-    put_line(at, buf);
-    va_end(args);	
+    at_stream_vprintf(&s, cmd, args);
+    va_end(args);
+    at_stream_write(&s, "\r\n", 2);
+    at_stream_flush(&s);
+    at->stats.tx_truncated += s.truncated;
+    if (s.flushes == 1 && s.total <= sizeof(buf))     //Ϊ
+        at->cfg.debug("->\r\n%.*s\r\n", (int)s.total - 2, buf);
+    else
+        at->cfg.debug("->\r\n%s(%u bytes)\r\n", cmd, s.total - 2);
 }
 
 /*
@@ -57,23 +129,147 @@ static void at_print(at_obj_t *at, const char *cmd, ...)
 static void recvbuf_clr(at_obj_t *at)
 {
     at->rcv_cnt = 0;
+    if (at->resp != NULL && at->resp->lines != NULL)
+        at_lines_reset(at->resp->lines);
 }
 
-//ȴATӦ
-static at_return wait_resp(at_obj_t *at, at_respond_t *r)
+/*
+ * @brief   ȡս
+ */
+static const at_result_t *result_table(at_obj_t *at, int *count)
+{
+    if (at->cfg.result_tbl == NULL) {
+        *count = AT_RESULT_DEF_COUNT;
+        return at_result_def;
+    }
+    *count = at->cfg.result_count;
+    return at->cfg.result_tbl;
+}
+
+/*
+ * @brief   ʼӦƥ(ƥ䴮 + ս)
+ * @return  ƥ䴮ƥ, -1 - (matcherΪ), Ϊ(ִд)
+ */
+static int matcher_setup(at_obj_t *at, at_match_t *m, const char *matcher)
+{
+    const at_result_t *tbl;
+    int i, n, count, ok;
+    at_match_reset(m);
+    ok  = at_match_add(m, matcher);
+    tbl = result_table(at, &count);
+    for (i = 0; i < count; i++) {
+        if ((n = strlen(tbl[i].code)) > 0)
+            at_match_add_flags(m, tbl[i].code, AT_MATCH_BOL |
+                               (tbl[i].code[n - 1] == ':' ? AT_MATCH_EOL : 0));
+    }
+    return ok;
+}
+
+/*
+ * @brief   ¼ս
+ * @param[in]   idx - ƥ
+ * @param[in]   end - ڽջеĽλ
+ */
+static void result_decode(at_obj_t *at, at_respond_t *r, int idx, unsigned int end)
+{
+    const at_result_t *tbl;
+    int i, count;
+    tbl = result_table(at, &count);
+    for (i = 0; i < count && tbl[i].code != at->matcher.pat[idx].str; i++) {}
+    if (i < count)                                    //ģʽһؽ
+        r->result = tbl[i].cls;
+    if (at->matcher.pat[idx].flags & AT_MATCH_EOL)
+        r->code = at_result_code(r->recvbuf, end);
+}
+
+//׼ATӦ(ڷ֮ǰ, ⶪʧӦ)
+static void resp_begin(at_obj_t *at, at_respond_t *r, const char *cmd)
 {    
+    while (at_sem_wait(&at->completed, 0)) {}         /*ϴγʱĲź*/
+    at->resp_tmo = r->timeout ? r->timeout : 
+                   at_lat_timeout(&at->lat, cmd, AT_DEF_TIMEOUT, 0);
+    at->match_ok = matcher_setup(at, &at->matcher, r->matcher);
+    r->result = AT_RESULT_NONE;
+    r->code   = -1;
     at->resp  = r;
     at->ret   = AT_RET_TIMEOUT;
     at->resp_timer = at_get_ms();    
+    at->tx_us      = at_get_us();
+    at->first_rx   = 1;
     recvbuf_clr(at);                    //սջ
     at->wait  = 1;
-    at_sem_wait(&at->completed, r->timeout);        
+}
+
+//ȴATӦ
+static at_return wait_resp(at_obj_t *at, at_respond_t *r)
+{    
+    at_sem_wait(&at->completed, at->resp_tmo);        
     at->cfg.debug("<-\r\n%s\r\n", r->recvbuf);
     at->resp = NULL;
     at->wait = 0;
     return at->ret;
 }
 
+/*
+ * @brief       ¼ʱ(ʱԳʱʱ)
+ */
+static void latency_update(at_obj_t *at, const char *cmd, at_return ret)
+{
+    if (ret == AT_RET_OK || ret == AT_RET_ERROR)
+        at_lat_add(&at->lat, cmd, at_get_ms() - at->resp_timer);
+    else if (ret == AT_RET_TIMEOUT)
+        at_lat_add(&at->lat, cmd, at->resp_tmo);
+}
+
+/*
+ * @brief       ȴδURCн(URC)
+ * @details     ߳ннճʱ(100ms)ʱͷline_idle, ѯ;
+ *              ʱ߳δ(ҵģʽδʱat_poll)ʱ, ɱ߳
+ *              кֱӷ
+ */
+static void wait_line_idle(at_obj_t *at)
+{
+    unsigned int elapsed;
+    while (at_sem_wait(&at->line_idle, 0)) {}         /*ϴεĲź*/
+    while (at->urc_cnt > 0) {
+        at->line_wait = 1;
+        AT_RING_BARRIER();                            /*ñ־ټ, ߳෴*/
+        if (at->urc_cnt == 0)
+            break;
+        elapsed = at_get_ms() - at->urc_timer;
+        if (elapsed > 100) {                          //URCѳʱ, ڼ
+            at->urc_cnt = 0;
+            at->stats.urc_dropped++;
+            at->cfg.debug("urc recv timeout, dropped before cmd\r\n");
+            break;
+        }
+        at_sem_wait(&at->line_idle, 101 - elapsed);   //յݻˢurc_timer
+    }
+    at->line_wait = 0;
+}
+
+/*
+ * @brief       ҵģʽȡ(δṩӿʱat_rx_pushдĻλȡ)
+ */
+static unsigned int work_read(at_obj_t *at, void *buf, unsigned int len)
+{
+    unsigned char *p;
+    unsigned int n, total = 0;
+    if (at->cfg.read != NULL)
+        return at->cfg.read(buf, len);
+    while (total < len) {
+        p = at_ring_rspan(&at->rx, &n);
+        if (n == 0)
+            break;
+        if (n > len - total)
+            n = len - total;
+        memcpy((char *)buf + total, p, n);
+        at_ring_consume(&at->rx, n);
+        total += n;
+    }
+    return total;
+}
+
 /*
  * @brief       ͬӦATӦ
  * @param[in]   resp    - ȴմ("OK",">")
@@ -83,24 +279,24 @@ at_return wait_resp_sync(struct at_obj *at, const char *resp,
                          unsigned int timeout)
 {
     char buf[64];
-    int cnt = 0, len;
-    at_return ret = AT_RET_TIMEOUT;
+    unsigned int cnt = 0, len;
+    int idx = -1, ok;
+    at_match_t m;
     unsigned int timer = at_get_ms();
+    ok = matcher_setup(at, &m, resp);
     while (at_get_ms() - timer < timeout) {
-        len = at->cfg.read(buf, sizeof(buf) - cnt);
+        if (cnt >= sizeof(buf) - 1)                   /*ڵ*/
+            cnt = 0;
+        len = work_read(at, buf + cnt, sizeof(buf) - 1 - cnt);
+        idx = at_match_feed(&m, buf + cnt, len, NULL);
         cnt += len;
         buf[cnt] = '\0';
-        if (strstr(buf, resp)) {
-            ret =  AT_RET_OK;
+        if (idx >= 0)
             break;
-        } else if (strstr(buf, "ERROR")) {
-            ret =  AT_RET_ERROR;
-            break;
-        }
         at_delay(10);
     }
     at->cfg.debug("%s", buf);
-    return ret;
+    return idx < 0 ? AT_RET_TIMEOUT : idx == ok ? AT_RET_OK : AT_RET_ERROR;
 }
 
 
@@ -112,18 +308,43 @@ void at_obj_create(at_obj_t *at, const at_conf_t cfg)
     at_work_env_t *e;
     at->cfg  = cfg;
     at->rcv_cnt = 0;
+    if (cfg.read == NULL)                             //at_rx_pushд
+        at->cfg.rx_notify = 1;
+    if (cfg.rx_buf != NULL)
+        at_ring_init(&at->rx, cfg.rx_buf, cfg.rx_bufsize);
+    else
+        at_ring_init(&at->rx, at->rx_def, sizeof(at->rx_def));
+    at_lat_init(&at->lat, cfg.lat_tbl, cfg.lat_count, cfg.tmo_min, cfg.tmo_max);
+    at_stats_clear(&at->stats);
+    at->first_rx = 0;
     
-    at_sem_init(&at->cmd_lock, 1);
+    at_sem_init(&at->req_lock, 1);
+    INIT_LIST_HEAD(&at->req_q);
+    at->owned    = 0;
     at_sem_init(&at->completed, 0);
+    at_sem_init(&at->line_idle, 0);
+    at_sem_init(&at->async_lock, 1);
+    INIT_LIST_HEAD(&at->async_q);
+    at->async_run = NULL;
+    at->line_wait = 0;
+    at->wake      = NULL;
+    if (!def_reader_ready) {
+        at_reader_init(&def_reader);
+        def_reader_ready = 1;
+    }
     e          = &at->env;
     e->at      = at;
     e->printf  = at_print;
+    e->tmpl    = tmpl_line;
     e->recvclr = recvbuf_clr;
     e->read    = cfg.read;
+    e->recv    = work_read;
     e->write   = cfg.write;
     e->wait_resp = wait_resp_sync;
     
-    list_add_tail(&at->node, &atlist);
+    at->reader = NULL;
+    at_urc_update(at, cfg.utc_tbl, cfg.urc_tbl_count);
+    at_reader_attach(&def_reader, at);
     
 }
 
@@ -132,7 +353,283 @@ void at_obj_create(at_obj_t *at, const at_conf_t cfg)
  */
 void at_obj_destroy(at_obj_t *at)
 {
-    list_del(&at->node);
+    at_reader_detach(at);
+}
+
+/*ͨ ---------------------------------------------------------------*/
+typedef struct {
+    struct list_head        node;
+    at_sem_t               *sem;                                /*ź(ȴߵĻlocal)*/
+    at_sem_t                local;                              /*δָȴʱʱź*/
+    unsigned char           prio;
+    volatile unsigned char  granted;                            /*ѻͨ*/
+}at_req_t;
+
+static void req_lock(at_obj_t *at)
+{
+    while (!at_sem_wait(&at->req_lock, AT_IDLE_WAIT)) {}
+}
+
+/*
+ * @brief       ֱռͨ(ͨŶ)
+ * @note        ǰreq_lock
+ */
+static bool chan_try(at_obj_t *at)
+{
+    if (at->owned || !list_empty(&at->req_q))
+        return false;
+    at->owned = 1;
+    return true;
+}
+
+/*
+ * @brief       ȴ(ͬȼȵȵ)
+ */
+static void req_insert(at_obj_t *at, at_req_t *req)
+{
+    struct list_head *pos;
+    at_req_t *it;
+    list_for_each(pos, &at->req_q) {
+        it = list_entry(pos, at_req_t, node);
+        if (it->prio < req->prio)
+            break;
+    }
+    list_add_tail(&req->node, pos);                   //뵽һȼ֮ǰ
+}
+
+/*
+ * @brief       ռͨ
+ * @details     ÿŶԼźϵȴ(ȴߵź, δָȴʱ
+ *              ʱź), ͷͨʱֻѶ
+ * @param[in]   opt     - ѡ, ΪNULLʱͨȼ
+ * @param[in]   timeout - Ŷ(ms), opt->deadline0ʱΪ׼
+ * @return      false - δͨ(ѴӶƳ, ִ)
+ */
+static bool chan_acquire(at_obj_t *at, const at_req_opt_t *opt, unsigned int timeout)
+{
+    at_waiter_t *w = opt != NULL ? opt->waiter : NULL;
+    unsigned int start = at_get_ms(), elapsed;
+    at_req_t req;
+    if (opt != NULL && opt->deadline != 0)
+        timeout = opt->deadline;
+    if (w != NULL) {
+        w->requests++;
+        while (at_sem_wait(&w->sem, 0)) {}            /*ϴγںĲź*/
+    }
+    req.prio = opt != NULL ? opt->prio : AT_PRIO_NORMAL;
+    req_lock(at);
+    if (!(req.granted = chan_try(at))) {
+        if (w == NULL)
+            at_sem_init(&req.local, 0);
+        req.sem = w != NULL ? &w->sem : &req.local;
+        req_insert(at, &req);
+    }
+    at_sem_post(&at->req_lock);
+    if (req.granted)
+        return true;
+    while (!req.granted && (elapsed = at_get_ms() - start) < timeout)
+        at_sem_wait(req.sem, timeout - elapsed);
+    req_lock(at);                                     //˺chan_releaseٷreq
+    if (!req.granted) {                               //, Ƴ
+        list_del(&req.node);
+        at->stats.req_expired++;                      //߳д, 
+    }
+    at_sem_post(&at->req_lock);
+    if (w == NULL)
+        at_sem_destroy(&req.local);
+    elapsed = at_get_ms() - start;
+    if (w != NULL) {
+        w->queued++;
+        w->wait_ms += elapsed;
+        if (elapsed > w->wait_max)
+            w->wait_max = elapsed;
+        if (!req.granted)
+            w->expired++;
+    }
+    return req.granted;
+}
+
+/*
+ * @brief       ͷͨ()
+ */
+static void chan_release(at_obj_t *at)
+{
+    at_req_t *req;
+    req_lock(at);
+    if (list_empty(&at->req_q)) {
+        at->owned = 0;
+    } else {
+        req = list_first_entry(&at->req_q, at_req_t, node);
+        list_del(&req->node);
+        req->granted = 1;
+        at_sem_post(req->sem);
+    }
+    at_sem_post(&at->req_lock);
+}
+
+/*
+ * @brief       ʼȴ(ÿֻ߳һ)
+ */
+void at_waiter_init(at_waiter_t *w)
+{
+    at_sem_init(&w->sem, 0);
+    w->requests = w->queued = w->expired = 0;
+    w->wait_ms  = w->wait_max = 0;
+}
+
+/*
+ * @brief       ȡ߳
+ */
+static void reader_lock(at_reader_t *r)
+{
+    while (!at_sem_wait(&r->lock, AT_IDLE_WAIT)) {}
+}
+
+/*
+ * @brief       ȡ߳, ȴ߳̽Ըöڽе
+ * @return      ߳(ѳ, ͷǰ̲߳ᴦö),
+ *              NULL - δҶ߳
+ * @note        ڶ߳(URC)е
+ */
+static at_reader_t *reader_hold(at_obj_t *at)
+{
+    at_reader_t *r = at->reader;
+    if (r == NULL)
+        return NULL;
+    reader_lock(r);
+    while (r->busy == at) {
+        r->idle_wait++;
+        at_sem_post(&r->lock);
+        if (at->cfg.read_wake != NULL)
+            at->cfg.read_wake();                      //ǰ
+        while (!at_sem_wait(&r->idle, AT_IDLE_WAIT)) {}
+        reader_lock(r);
+    }
+    return r;
+}
+
+/*
+ * @brief       Ѷ߳(δҶ߳ʱ֪ͨⲿ¼ѭ)
+ * @note        ߳read_waitʱֻͨcfg.read_wake, δṩʱ
+ *              ڱʱ(AT_IDLE_WAIT)
+ */
+static void reader_wake(at_obj_t *at)
+{
+    if (at->reader != NULL) {
+        at_sem_post(&at->reader->event);
+        if (at->cfg.read_wake != NULL)
+            at->cfg.read_wake();
+    } else if (at->wake != NULL)
+        at->wake(at->wake_param);
+}
+
+static void async_lock(at_obj_t *at)
+{
+    while (!at_sem_wait(&at->async_lock, AT_IDLE_WAIT)) {}
+}
+
+/*
+ * @brief       첽(߳ѽ״̬ΪAT_ASYNC_SENDING)
+ */
+static void async_send(at_obj_t *at, at_async_t *a)
+{
+    resp_begin(at, a->resp, a->cmd);
+    AT_RING_BARRIER();                                //waitλж
+    a->state = AT_ASYNC_RUNNING;
+    put_line(at, a->cmd);
+    reader_wake(at);                                  //̰߳µӦʱ
+}
+
+/*
+ * @brief       Ŷӵ첽(̵߳)
+ * @details     async_runǿʱͨ첽ռ
+ */
+static void async_next(at_obj_t *at)
+{
+    at_async_t *a = at->async_run;
+    if (a == NULL ? list_empty(&at->async_q) : a->state != AT_ASYNC_QUEUED)
+        return;
+    async_lock(at);
+    if (at->async_run == NULL && !list_empty(&at->async_q)) {
+        req_lock(at);
+        if (chan_try(at)) {                           //: Ŷӵͬʱ
+            a = list_first_entry(&at->async_q, at_async_t, node);
+            list_del(&a->node);
+            at->async_run = a;
+        }
+        at_sem_post(&at->req_lock);
+    }
+    a = at->async_run;
+    if (a != NULL && a->state == AT_ASYNC_QUEUED && at->urc_cnt == 0 && !at->suspend)
+        a->state = AT_ASYNC_SENDING;                  //URCδʱɶ߳Ժ
+    else
+        a = NULL;
+    at_sem_post(&at->async_lock);
+    if (a != NULL)
+        async_send(at, a);
+}
+
+/*
+ * @brief       첽ɼ(̵߳)
+ */
+static void async_process(at_obj_t *at)
+{
+    at_async_t *a = at->async_run;
+    if (a == NULL || a->state != AT_ASYNC_RUNNING || at->wait) {
+        async_next(at);
+        return;
+    }
+    while (at_sem_wait(&at->completed, 0)) {}
+    at->cfg.debug("<-\r\n%s\r\n", a->resp->recvbuf);
+    at->resp = NULL;
+    a->ret   = at->ret;
+    latency_update(at, a->cmd, a->ret);
+    at->stats.cmd[a->ret]++;
+    async_lock(at);
+    if (!list_empty(&at->async_q) && list_empty(&at->req_q)) {
+        at->async_run = list_first_entry(&at->async_q, at_async_t, node);
+        list_del(&at->async_run->node);               //ͬŶ, ֱͨӽһ
+    } else {
+        at->async_run = NULL;
+        chan_release(at);
+    }
+    at_sem_post(&at->async_lock);
+    a->state = AT_ASYNC_DONE;
+    if (a->cb != NULL)
+        a->cb(a);
+    at_sem_post(&a->done);
+    async_next(at);
+}
+
+/*
+ * @brief       ִ(ģ)
+ * @param[in]   cmd    - , ʹģʱΪģ崮(ʱͳ)
+ * @param[in]   t      - ģ, NULL - ֱӷcmd
+ */
+static at_return cmd_exec(at_obj_t *at, at_respond_t *r, const at_req_opt_t *opt,
+                          const char *cmd, const at_tmpl_t *t, const at_arg_t *args)
+{
+    at_return ret;
+    char      defbuf[64];
+    at_respond_t  default_resp = {"OK", defbuf, sizeof(defbuf), 0};
+    if (r == NULL) {
+        r = &default_resp;                 //ĬӦ      
+    }
+    if (!chan_acquire(at, opt, r->timeout ? r->timeout : AT_DEF_TIMEOUT)) {
+        return AT_RET_TIMEOUT;    
+    }
+    wait_line_idle(at);
+    resp_begin(at, r, cmd);
+    if (t != NULL)
+        tmpl_line(at, t, args);
+    else
+        put_line(at, cmd);
+    ret = wait_resp(at, r); 
+    latency_update(at, cmd, ret);
+    at->stats.cmd[ret]++;
+    chan_release(at);
+    async_next(at);
+    return ret;    
 }
 
 /*
@@ -142,22 +639,69 @@ void at_obj_destroy(at_obj_t *at)
  * @param[in]   args   - б
  */
 at_return at_do_cmd(at_obj_t *at, at_respond_t *r, const char *cmd)
+{
+    return at_do_cmd_opt(at, r, cmd, NULL);
+}
+
+/*
+ * @brief       ָȼ/Ŷִ
+ * @param[in]   opt    - ѡ, ΪNULLʱͬat_do_cmd
+ * @return      AT_RET_TIMEOUT - ӦʱŶӳ(δ)
+ */
+at_return at_do_cmd_opt(at_obj_t *at, at_respond_t *r, const char *cmd, 
+                        const at_req_opt_t *opt)
+{
+    return cmd_exec(at, r, opt, cmd, NULL, NULL);
+}
+
+/*
+ * @brief       ģִ(ʱʽ)
+ * @param[in]   t      - ѱģ
+ * @param[in]   args   - ģ
+ */
+at_return at_do_cmd_tmpl(at_obj_t *at, at_respond_t *r, const at_tmpl_t *t, 
+                         const at_arg_t *args)
+{
+    return cmd_exec(at, r, NULL, t->fmt, t, args);
+}
+
+/*
+ * @brief       ( -> ʾ">" ->  -> )
+ * @param[in]   r      - Ӧ(ƥ䴮"SEND OK"), ΪNULLʱȴ"OK", 3sʱ
+ * @param[in]   cmd    - ("AT+CIPSEND=0,100")
+ * @param[in]   buf    - 
+ * @param[in]   len    - ݳ
+ * @return      AT_RET_OK - ͳɹ
+ */
+at_return at_send_data(at_obj_t *at, at_respond_t *r, const char *cmd, 
+                       const void *buf, unsigned int len)
 {
     at_return ret;
     char      defbuf[64];
-    at_respond_t  default_resp = {"OK", defbuf, sizeof(defbuf), 3000};
+    at_respond_t  default_resp = {"OK", defbuf, sizeof(defbuf), 0};
+    at_respond_t  prompt;
     if (r == NULL) {
         r = &default_resp;                 //ĬӦ      
     }
-    if (!at_sem_wait(&at->cmd_lock, r->timeout)) {
+    if (!chan_acquire(at, NULL, r->timeout ? r->timeout : AT_DEF_TIMEOUT)) {
         return AT_RET_TIMEOUT;    
     }
-    while (at->urc_cnt) {
-        at_delay(10);
-    }
+    wait_line_idle(at);
+    prompt = *r;
+    prompt.matcher = AT_DATA_PROMPT;
+    resp_begin(at, &prompt, cmd);
     put_line(at, cmd);
-    ret = wait_resp(at, r); 
-    at_sem_post(&at->cmd_lock);
+    ret = wait_resp(at, &prompt);
+    latency_update(at, cmd, ret);
+    if (ret == AT_RET_OK) {
+        resp_begin(at, r, NULL);
+        at->cfg.write(buf, len);                        //ʾ֮鷢
+        at->stats.tx_bytes += len;
+        ret = wait_resp(at, r);
+    }
+    at->stats.cmd[ret]++;
+    chan_release(at);
+    async_next(at);
     return ret;    
 }
 
@@ -168,23 +712,88 @@ at_return at_do_cmd(at_obj_t *at, at_respond_t *r, const char *cmd)
  */
 int at_do_work(at_obj_t *at, at_work work, void *params)
 {
+    at_reader_t *r;
     int ret;
-    if (!at_sem_wait(&at->cmd_lock, 150 * 1000)) {
+    if (!chan_acquire(at, NULL, at->cfg.work_timeout ? at->cfg.work_timeout : 
+                      AT_WORK_TIMEOUT)) {
         return AT_RET_TIMEOUT;    
     }    
     at->env.params = params;
     at->dowork = true;
+    if ((r = reader_hold(at)) != NULL)              //ȴ߳̽ڽе
+        at_sem_post(&r->lock);
     ret = work(&at->env);
     at->dowork = false;
-    at_sem_post(&at->cmd_lock);
+    chan_release(at);
+    async_next(at);
     return ret;
 }
 
+/*
+ * @brief       ʼ첽(ÿֻһ)
+ */
+void at_async_init(at_async_t *a)
+{
+    at_sem_init(&a->done, 0);
+    a->state = AT_ASYNC_IDLE;
+}
+
+/*
+ * @brief       ִ첽(, ɶ߳Ŷӵ)
+ * @param[in]   a      - , (at_async_init)ǰظύ
+ * @param[in]   r      - Ӧ(ΪNULL), timeoutΪ0ʱʹӦʱ
+ * @param[in]   cmd    - 
+ * @param[in]   cb     - ɻص, ڶִ߳, ɵͬӿ
+ * @return      false - ʹû
+ * @note        ɺͨصat_async_waitat_async_doneȡ(a->ret);
+ *              Ӧʱɶ߳(at_thread/at_reader_run)
+ */
+bool at_do_cmd_async(at_obj_t *at, at_async_t *a, at_respond_t *r, const char *cmd,
+                     void (*cb)(at_async_t *a), void *param)
+{
+    if (r == NULL || (a->state != AT_ASYNC_IDLE && a->state != AT_ASYNC_DONE))
+        return false;
+    while (at_sem_wait(&a->done, 0)) {}
+    a->cmd   = cmd;
+    a->resp  = r;
+    a->cb    = cb;
+    a->param = param;
+    a->ret   = AT_RET_TIMEOUT;
+    a->state = AT_ASYNC_QUEUED;
+    async_lock(at);
+    list_add_tail(&a->node, &at->async_q);
+    at_sem_post(&at->async_lock);
+    async_next(at);                                   //ʱɵֱ߳ӷ
+    reader_wake(at);
+    return true;
+}
+
+/*
+ * @brief       ѯ첽Ƿ
+ */
+bool at_async_done(at_async_t *a)
+{
+    return a->state == AT_ASYNC_DONE;
+}
+
+/*
+ * @brief       ȴ첽
+ * @param[in]   timeout - ȴʱ(ms)
+ * @return      , ȴʱAT_RET_TIMEOUT(ִ)
+ */
+at_return at_async_wait(at_async_t *a, unsigned int timeout)
+{
+    if (a->state != AT_ASYNC_DONE && !at_sem_wait(&a->done, timeout))
+        return AT_RET_TIMEOUT;
+    return a->ret;
+}
+
 /*
  * @brief       ָӦ
  * @param[in]   recvbuf - ջ 
  * @param[out]  lines   - Ӧ
  * @return      
+ * @note        ','ָһ޸Ļ, ʶ, ´ʹat_parse.h
  */
 int at_split_respond_lines(char *recvbuf, char *lines[], int count)
 {
@@ -205,63 +814,222 @@ int at_split_respond_lines(char *recvbuf, char *lines[], int count)
 }
 
 /*
- * @brief       urc 
+ * @brief       URCؽǰ׺
+ * @param[in]   tbl   - URC(ɴat->cfg.utc_tbl, ޸ĺؽ)
+ * @param[in]   count - 
+ * @return      false - ڵز, ˻Ϊƥ
+ * @note        ؽڼж߳, ߳ͣöĽ;
+ *              URCе. ⲿ¼ѭĶ¼ѭ
+ *              ߳(at_obj_process֮)
+ */
+bool at_urc_update(at_obj_t *at, utc_item_t *tbl, unsigned short count)
+{
+    at_reader_t *r = reader_hold(at);
+    bool ret = false;
+    unsigned short i, k = 0;
+    at->urc_indexed       = 0;
+    at->cfg.utc_tbl       = tbl;
+    at->cfg.urc_tbl_count = count;
+    for (i = 0; i < count; i++) {                     /*ռ*/
+        if (tbl[i].endmark != '\0' && k < sizeof(at->urc_endmarks) - 1 &&
+            memchr(at->urc_endmarks, tbl[i].endmark, k) == NULL)
+            at->urc_endmarks[k++] = tbl[i].endmark;
+    }
+    at->urc_endmarks[k] = '\0';
+    if (at->cfg.urc_nodes != NULL) {
+        at_prefix_init(&at->urc_idx, at->cfg.urc_nodes, at->cfg.urc_node_count);
+        for (i = 0; i < count && at_prefix_add(&at->urc_idx, tbl[i].prefix, i); i++) {}
+        if (i < count) {
+            at->cfg.debug("URC index overflow\r\n");
+        } else {
+            at->urc_indexed = 1;
+            ret = true;
+        }
+    }
+    if (r != NULL)
+        at_sem_post(&r->lock);
+    return ret;
+}
+
+/*
+ * @brief       URC
  * @param[in]   urcline - URC
- * @return      none
+ * @return      ƥ(˳һƥǰ׺), NULL - ƥ
  */
-static void urc_handler_entry(at_obj_t *at, char *urcline, unsigned int size)
+static utc_item_t *urc_lookup(at_obj_t *at, const char *urcline, unsigned int size)
 {
     int i, n;
     utc_item_t *tbl = at->cfg.utc_tbl;
-    
+    if (at->urc_indexed) {
+        i = at_prefix_match(&at->urc_idx, urcline, size);
+        return i < 0 ? NULL : &tbl[i];
+    }
     for (i = 0; i < at->cfg.urc_tbl_count; i++){
         n = strlen(tbl->prefix);
-        if (n > 0 && strncmp(urcline, tbl->prefix, n) == 0) {            
-            tbl->handler(urcline, size);
-            at->cfg.debug("<=\r\n%s\r\n", urcline);
-            return;
-        }    
+        if (n > 0 && (unsigned int)n <= size && memcmp(urcline, tbl->prefix, n) == 0)
+            return tbl;
         tbl++;
     }
+    return NULL;
+}
+
+/*
+ * @brief       URC
+ */
+static void urc_count(at_obj_t *at, utc_item_t *item)
+{
+    at->stats.urc_lines++;
+    if (at->cfg.urc_hits != NULL)
+        at->cfg.urc_hits[item - at->cfg.utc_tbl]++;
+}
+
+/*
+ * @brief       urc 
+ * @param[in]   urcline - URC
+ * @return      none
+ */
+static void urc_handler_entry(at_obj_t *at, char *urcline, unsigned int size)
+{
+    utc_item_t *item = urc_lookup(at, urcline, size);
+    if (item != NULL) {
+        urc_count(at, item);
+        item->handler(urcline, size);
+        at->cfg.debug("<=\r\n%s\r\n", urcline);
+        return;
+    }
     
     if (size >= 2 && !at->wait)              //Զ
         at->cfg.debug("%s\r\n", urcline);          
 }
 
+/*
+ * @brief       ׷ݵURCл
+ */
+static void urc_append(at_obj_t *at, const char *buf, unsigned int n)
+{
+    if (at->urc_cnt + n >= at->cfg.urc_bufsize) {       //
+        at->urc_cnt = 0;
+        at->stats.urc_overflow++;
+        at->stats.urc_dropped++;
+        if (n >= at->cfg.urc_bufsize)
+            n = 0;
+    }
+    memcpy(at->cfg.urc_buf + at->urc_cnt, buf, n);
+    at->urc_cnt += n;
+}
+
 /*
  * @brief       urc մ
- * @param[in]   buf  - ջ
- * @return      none
+ * @param[in]   buf  - ջ(λڵ)
+ * @return      Ѵ, URC(at_recv_data)ʱ, 
+ *              ݲٰд
  */
-static void urc_recv_process(at_obj_t *at, const char *buf, unsigned int size)
+static unsigned int urc_recv_process(at_obj_t *at, char *buf, unsigned int size)
 {
-    char *urc_buf;	
-    unsigned short urc_size;
-    unsigned char  c;
+    char *urc_buf, *end, *s, *start = buf, c;	
+    unsigned int n;
+    utc_item_t *item;
     urc_buf  = (char *)at->cfg.urc_buf;
-    urc_size = at->cfg.urc_bufsize;
-    if (at->urc_cnt > 0 && size == 0) {
-        if (AT_IS_TIMEOUT(at->urc_timer, 100)) {               //100msʱ
+    if (size == 0) {
+        if (at->urc_cnt > 0 && AT_IS_TIMEOUT(at->urc_timer, 100)) {  //100msʱ
             urc_buf[at->urc_cnt] = '\0';
             at->urc_cnt = 0;
+            at->stats.urc_dropped++;
             at->cfg.debug("urc recv timeout=>%s\r\n", urc_buf);       
         }
-    } else {
-        at->urc_timer = at_get_ms();
-        while (size--) {
-            c = *buf++;
-            if (c == '\r' || c == '\n') {                       //յ1
+        return 0;
+    }
+    at->urc_timer = at_get_ms();
+    for (end = buf + size, s = buf; s < end; s++) {
+        c = *s;
+        if (c == '\r' || c == '\n') {                        //յ1
+            n = s - buf;
+            if (at->urc_cnt == 0) {                         //ڻ,ԭش
+                if (n > 2) {
+                    *s = '\0';
+                    urc_handler_entry(at, buf, n);
+                    *s = c;
+                }
+            } else {
+                urc_append(at, buf, n);
                 urc_buf[at->urc_cnt] = '\0';
                 if (at->urc_cnt > 2)
                     urc_handler_entry(at, urc_buf, at->urc_cnt);
                 at->urc_cnt = 0;
-            } else {
-                urc_buf[at->urc_cnt++] = c;
-                if (at->urc_cnt >= urc_size)                    //
-                    at->urc_cnt = 0;
             }
+            buf = s + 1;
+        } else if (c != '\0' && strchr(at->urc_endmarks, c) != NULL) {
+            if (at->urc_cnt > 0) {                          //ǻнURC("+IPD,5:")
+                urc_append(at, buf, s + 1 - buf);
+                buf = s + 1;
+                item = urc_lookup(at, urc_buf, at->urc_cnt);
+            } else
+                item = urc_lookup(at, buf, s + 1 - buf);
+            if (item == NULL || item->endmark != c)
+                continue;
+            urc_append(at, buf, s + 1 - buf);
+            buf = s + 1;
+            urc_buf[at->urc_cnt] = '\0';
+            urc_count(at, item);
+            item->handler(urc_buf, at->urc_cnt);
+            at->cfg.debug("<=\r\n%s\r\n", urc_buf);
+            at->urc_cnt = 0;
+            if (at->raw_left > 0)                           //Ϊ
+                return s + 1 - start;
         }
     }
+    urc_append(at, buf, end - buf);
+    return size;
+}
+
+/*
+ * @brief       մ(, ׷'\0')
+ * @return      Ѵ
+ */
+static unsigned int raw_recv_process(at_obj_t *at, const void *buf, unsigned int size)
+{
+    if (size > at->raw_left)
+        size = at->raw_left;
+    at->raw_left -= size;
+    at->urc_timer = at_get_ms();
+    at->raw_sink(at->raw_param, buf, size);
+    return size;
+}
+
+/*
+ * @brief       
+ * @details     յlenֽԭsink, URCмӦƥ, 
+ *              "+IPD,<len>:"֮Ķ, һURCе
+ * @param[in]   len   - ճ
+ * @param[in]   sink  - ݽ(ܱε)
+ * @param[in]   param - sink
+ * @return      none
+ */
+void at_recv_data(at_obj_t *at, unsigned int len, at_sink_t sink, void *param)
+{
+    at->raw_sink  = sink;
+    at->raw_param = param;
+    at->raw_left  = sink != NULL ? len : 0;
+}
+
+/*
+ * @brief       Ӧʱ/ֹ
+ * @return      none
+ */
+static void resp_timeout_check(at_obj_t *at)
+{
+    if (!at->wait || at->resp == NULL)
+        return;
+    if (AT_IS_TIMEOUT(at->resp_timer, at->resp_tmo))
+        at->ret = AT_RET_TIMEOUT;		
+    else if (at->suspend)                           //ǿֹ
+        at->ret = AT_RET_ABORT;
+    else
+        return;
+    if (at->resp->lines)
+        at_lines_finish(at->resp->lines, at->resp->recvbuf, at->rcv_cnt, false);
+    at->wait = 0;
+    at_sem_post(&at->completed);
 }
 
 /*
@@ -274,7 +1042,10 @@ static void resp_recv_process(at_obj_t *at, const char *buf, unsigned int size)
 {
     char *rcv_buf;
     unsigned short rcv_size;	
+    unsigned int n = size, end;
+    const char *s = buf;
     at_respond_t *resp = at->resp;
+    int idx;
     
     if (resp == NULL || size  == 0)
         return;
@@ -282,29 +1053,48 @@ static void resp_recv_process(at_obj_t *at, const char *buf, unsigned int size)
     rcv_buf  = (char *)resp->recvbuf;
     rcv_size = resp->bufsize;
 
-    if (at->rcv_cnt + size >= rcv_size) {             //
+    if (at->rcv_cnt + n >= rcv_size) {                //
         at->rcv_cnt = 0;
+        if (resp->lines)
+            at_lines_reset(resp->lines);
+        at->stats.rx_overflow++;
         at->cfg.debug("Receive overflow:%s", rcv_buf);
+        if (n >= rcv_size) {                          //ֻ󲿷
+            s += n - rcv_size + 1;
+            n  = rcv_size - 1;
+        }
     }
     /*յݷrcv_buf ---------------------------------------------*/
-    memcpy(rcv_buf + at->rcv_cnt, buf, size);
-    at->rcv_cnt += size;
+    memcpy(rcv_buf + at->rcv_cnt, s, n);
+    at->rcv_cnt += n;
     rcv_buf[at->rcv_cnt] = '\0';
     
 
     if (!at->wait)
         return;    
-    if (strstr(rcv_buf, resp->matcher)) {            //ƥ
+    if (at->first_rx) {                             //->ֽʱ
+        at->first_rx = 0;
+        at_stats_hist(at->stats.first_byte, at_get_us() - at->tx_us);
+    }
+    idx = at_match_feed(&at->matcher, buf, size, &n);
+    if (idx < 0) {
+        if (resp->lines)
+            at_lines_feed(resp->lines, rcv_buf, at->rcv_cnt);
+        resp_timeout_check(at);
+        return;
+    }
+    n   = size - n;
+    end = at->rcv_cnt > n ? at->rcv_cnt - n : 0;     //ĩβ
+    at_stats_hist(at->stats.final_result, at_get_us() - at->tx_us);
+    if (idx == at->match_ok) {                      //ƥ
         at->ret = AT_RET_OK;
-    } else if (strstr(rcv_buf, "ERROR")) {
+    } else {                                        //ս(ִд)
         at->ret = AT_RET_ERROR;
-    } else if (AT_IS_TIMEOUT(at->resp_timer, resp->timeout)) {
-        at->ret = AT_RET_TIMEOUT;		
-    } else if (at->suspend)                         //ǿֹ
-        at->ret = AT_RET_ABORT;
-    else
-        return;
-    
+        result_decode(at, resp, idx, end);
+    }
+    if (resp->lines)                                //нṹֹĩβ
+        at_lines_finish(resp->lines, rcv_buf, end, true);
+    at->wait = 0;                                   //ÿֻ֪ͨһ
     at_sem_post(&at->completed);
 }
 
@@ -324,6 +1114,7 @@ bool at_obj_busy(at_obj_t *at)
 void at_suspend(at_obj_t *at)
 {
     at->suspend = 1;
+    reader_wake(at);                                //AT̴ֹ߳
 }
 
 /*
@@ -333,31 +1124,319 @@ void at_suspend(at_obj_t *at)
 void at_resume(at_obj_t *at)
 {
     at->suspend = 0;
+    async_next(at);
 }
 
 /*
- * @brief       ATѯ߳
+ * @brief       ֪ͨ
+ * @details     յݺ(cfg.rx_notify), AT߳û
+ *              ʱ, ֱյ֪ͨߵĳʱʱ
  * @return      none
  */
-void at_thread(void)
+void at_rx_notify(at_obj_t *at)
+{
+    at->rx_ready = 1;
+    if (at->reader != NULL)
+        at_sem_post(&at->reader->event);
+}
+
+/*
+ * @brief       㵽һʱʱ̵ʱ
+ * @return      ȴʱ(ms)
+ */
+static unsigned int next_timeout(at_obj_t *at)
+{
+    unsigned int t = AT_IDLE_WAIT, elapsed;
+    at_respond_t *r = at->resp;
+    if (at->wait && r != NULL) {
+        elapsed = at_get_ms() - at->resp_timer;
+        t = elapsed > at->resp_tmo ? 0 : at->resp_tmo - elapsed + 1;
+    }
+    if (at->urc_cnt > 0) {                            //URCнճʱ(100ms)
+        elapsed = at_get_ms() - at->urc_timer;
+        elapsed = elapsed > 100 ? 0 : 100 - elapsed + 1;
+        if (elapsed < t)
+            t = elapsed;
+    }
+    if (at->raw_left > 0) {                           //ճʱ(1s)
+        elapsed = at_get_ms() - at->urc_timer;
+        elapsed = elapsed > 1000 ? 0 : 1000 - elapsed + 1;
+        if (elapsed < t)
+            t = elapsed;
+    }
+    return t;
+}
+
+/*
+ * @brief       ȡ
+ * @param[in]   timeout - ȴʱ, 0 - 
+ */
+static unsigned int rx_read(at_obj_t *at, void *buf, unsigned int len, 
+                            unsigned int timeout)
+{
+    if (timeout > 0 && at->cfg.read_wait != NULL)
+        return at->cfg.read_wait(buf, len, timeout);
+    return at->cfg.read(buf, len);
+}
+
+/*
+ * @brief       ȡݵλ
+ * @param[in]   timeout - ȴʱ(read_waitʱЧ)
+ * @return      true - , пܻ(rx_readyλ)
+ */
+static bool rx_fill(at_obj_t *at, unsigned int timeout)
+{
+    unsigned char *p;
+    unsigned int len, n;
+    if (at->cfg.read == NULL || (at->cfg.rx_notify && !at->rx_ready && timeout == 0))
+        return false;
+    at->rx_ready = 0;
+    p = at_ring_wspan(&at->rx, &len);
+    n = len > 0 ? rx_read(at, p, len, timeout) : 0;
+    at_ring_commit(&at->rx, n);
+    while (n == len) {                                //, Ʋ
+        p = at_ring_wspan(&at->rx, &len);
+        if (len == 0) {
+            at->rx_ready = 1;
+            return true;
+        }
+        n = at->cfg.read(p, len);
+        at_ring_commit(&at->rx, n);
+    }
+    return false;
+}
+
+/*
+ * @brief       д(ж/DMAɻصֱӵ, cfg.read)
+ * @return      ʵд볤, λʱʣಿ(stats.rx_dropped)
+ * @note        ֻһ; жеʱat_sem_postΪжϰȫӿ
+ */
+unsigned int at_rx_push(at_obj_t *at, const void *buf, unsigned int len)
+{
+    unsigned int n = at_ring_put(&at->rx, buf, len);
+    if (n < len)
+        at->stats.rx_dropped += len - n;
+    if (n > 0)
+        at_rx_notify(at);
+    return n;
+}
+
+/*
+ * @brief       URCнʱѵȴ߳
+ */
+static void line_idle_signal(at_obj_t *at)
+{
+    AT_RING_BARRIER();                                //urc_cntټ־
+    if (at->line_wait && at->urc_cnt == 0) {
+        at->line_wait = 0;
+        at_sem_post(&at->line_idle);
+    }
+}
+
+/*
+ * @brief       ݽմ
+ * @details     ֱӶ뻷λ, ӦۻURCо
+ *              ڵݶϽ, еURCٸ
+ * @param[in]   timeout - ȴʱ(read_waitʱЧ)
+ * @return      none
+ */
+static void rx_process(at_obj_t *at, unsigned int timeout)
+{
+    unsigned char *p;
+    unsigned int len, n;
+    bool more = rx_fill(at, timeout);
+    p = at_ring_rspan(&at->rx, &len);
+    if (len == 0) {
+        urc_recv_process(at, NULL, 0);                //URCʱ
+        resp_timeout_check(at);
+        if (at->raw_left > 0 && AT_IS_TIMEOUT(at->urc_timer, 1000)) {
+            at->cfg.debug("raw recv timeout, %d bytes lost\r\n", at->raw_left);
+            at->raw_left = 0;
+        }
+    }
+    while (len > 0) {
+        if (at->raw_left > 0) {                       //ģʽ
+            n = raw_recv_process(at, p, len);
+        } else {
+            n = urc_recv_process(at, (char *)p, len);
+            resp_recv_process(at, (char *)p, n);
+        }
+        at->stats.rx_bytes += n;
+        at_ring_consume(&at->rx, n);
+        p = at_ring_rspan(&at->rx, &len);
+        if (len == 0 && more) {                       //Ѵ, ȡеʣ
+            more = rx_fill(at, 0);
+            p = at_ring_rspan(&at->rx, &len);
+        }
+    }
+    line_idle_signal(at);
+    async_process(at);
+}
+
+/*
+ * @brief       ʼ߳
+ * @return      none
+ */
+void at_reader_init(at_reader_t *r)
+{
+    INIT_LIST_HEAD(&r->objs);
+    at_sem_init(&r->lock, 1);
+    at_sem_init(&r->event, 0);
+    at_sem_init(&r->idle, 0);
+    r->busy      = NULL;
+    r->idle_wait = 0;
+    r->count     = 0;
+}
+
+/*
+ * @brief       ATҵָ߳(ڼɵ, Ӱ)
+ * @note        URCе
+ * @return      none
+ */
+void at_reader_attach(at_reader_t *r, at_obj_t *at)
+{
+    at_reader_detach(at);
+    reader_lock(r);
+    list_add_tail(&at->node, &r->objs);
+    r->count++;
+    at->reader = r;
+    at_sem_post(&r->lock);
+    at_sem_post(&r->event);
+}
+
+/*
+ * @brief       Ӷ߳ժAT, غ̲߳ٷʸö
+ * @note        ʱȴζȡ; URCе
+ * @return      none
+ */
+void at_reader_detach(at_obj_t *at)
+{
+    at_reader_t *r = reader_hold(at);
+    if (r == NULL)
+        return;
+    list_del(&at->node);
+    r->count--;
+    at->reader = NULL;
+    at_sem_post(&r->lock);
+}
+
+/*
+ * @brief       ATҵ̳߳и()Ķ߳
+ * @param[in]   pool  - ̳߳
+ * @param[in]   count - ߳
+ * @return      ѡеĶ߳
+ */
+at_reader_t *at_reader_attach_pool(at_reader_t *pool, int count, at_obj_t *at)
+{
+    at_reader_t *r = pool;
+    int i;
+    for (i = 1; i < count; i++) {
+        if (pool[i].count < r->count)
+            r = &pool[i];
+    }
+    at_reader_attach(r, at);
+    return r;
+}
+
+/*
+ * @brief       ߳ѭ(ÿ߳Ӧô, ߳е, )
+ * @details     жֽ֧֪ͨ(cfg.rx_notify)ʱ, ߳ڽ¼
+ *              ֱݵĳʱʱ; ֻһṩӿ
+ *              (cfg.read_wait)ʱ, ֱڶӿ; 1msѯ
+ * @return      none
+ */
+void at_reader_run(at_reader_t *r)
 {
     at_obj_t *at;
     struct list_head *list ,*n = NULL;     
-    int len;
-    char buf[32];
+    unsigned int timeout, t;
+    bool poll;
     while (1) {
+        timeout = AT_IDLE_WAIT;
+        poll    = false;
+        reader_lock(r);
+        if (list_is_singular(&r->objs)) {
+            at = list_first_entry(&r->objs, at_obj_t, node);
+            if (at->cfg.read_wait != NULL && !at->dowork) {
+                r->busy = at;                         //ڼͷ
+                at_sem_post(&r->lock);
+                rx_process(at, next_timeout(at));
+                reader_lock(r);
+                r->busy = NULL;
+                for (; r->idle_wait > 0; r->idle_wait--)
+                    at_sem_post(&r->idle);
+                at_sem_post(&r->lock);
+                continue;                             //¼doworkٶ
+            }
+        }
         /*at_obj*/
-        list_for_each_safe(list, n, &atlist) {
+        list_for_each_safe(list, n, &r->objs) {
             at = list_entry(list, at_obj_t, node);
-            if (!at->dowork) {
-#warning "ȡŻ(readline) ..."                
-                len = at->cfg.read(buf, sizeof(buf));
-                urc_recv_process(at, (char *)buf, len);
-                if (len > 0) {
-                    resp_recv_process(at, buf, len);
-                }
-            }        
+            if (!at->dowork)
+                rx_process(at, 0);
+            if (!at->cfg.rx_notify || at->dowork)
+                poll = true;
+            else if ((t = next_timeout(at)) < timeout)
+                timeout = t;
         }
-        at_delay(1);        
+        at_sem_post(&r->lock);
+        if (poll)
+            at_delay(1);        
+        else
+            at_sem_wait(&r->event, timeout);
+    }
+}
+
+/*
+ * @brief       һν볬ʱ(ⲿ¼ѭʹ, epollӦ)
+ * @param[in]   readable - ݿɶ
+ * @return      false - ҵģʽ(at_do_workȡ), δ
+ * @note        ⲿ¼ѭĶȵat_reader_detach߳
+ */
+bool at_obj_process(at_obj_t *at, bool readable)
+{
+    if (at->dowork)
+        return false;
+    if (readable)
+        at->rx_ready = 1;
+    rx_process(at, 0);
+    return true;
+}
+
+/*
+ * @brief       һγʱʱ
+ * @return      ʱ(ms), AT_NO_TIMEOUT - ޴ĳʱ()
+ * @note        ̷߳յӦ֮ǰɵ߳гʱ
+ */
+unsigned int at_obj_deadline(at_obj_t *at)
+{
+    if (!at->wait && at->urc_cnt == 0 && at->raw_left == 0)
+        return AT_NO_TIMEOUT;
+    return next_timeout(at);
+}
+
+/*
+ * @brief       ⲿ¼ѭѽӿ
+ * @details     δҶ̵߳ĶµĴⳬʱ(첽)Ҫֹ
+ *              (at_suspend)ʱwake, ¼ѭӦat_obj_process
+ *              at_obj_deadline¼ʱ
+ * @param[in]   wake  - ѽӿ(߳е), NULL - ȡ
+ */
+void at_obj_set_wake(at_obj_t *at, void (*wake)(void *param), void *param)
+{
+    at->wake_param = param;
+    at->wake       = wake;
+}
+
+/*
+ * @brief       ATѯ߳(Ĭ϶߳, δ̵ָ߳Ķ)
+ * @return      none
+ */
+void at_thread(void)
+{
+    if (!def_reader_ready) {
+        at_reader_init(&def_reader);
+        def_reader_ready = 1;
     }
+    at_reader_run(&def_reader);
 }
@@ -14,10 +14,50 @@
 #define _AT_H_
 
 #include "at_util.h"
+#include "at_prefix.h"
+#include "at_match.h"
+#include "at_parse.h"
+#include "at_tmpl.h"
+#include "at_stream.h"
+#include "at_latency.h"
+#include "at_stats.h"
+#include "at_ring.h"
 #include "list.h"
 #include <stdbool.h>
 
-#define MAX_AT_CMD_LEN          64
+/*
+ * MAX_AT_CMD_LENֿʽ; (%e %f %g %a)
+ * AT_STREAM_FLOAT_SIZE - 1ֽ, ֽضϲstats.tx_truncated
+ */
+#define MAX_AT_CMD_LEN          64                              /*ͷֿС(Ȳܴ)*/
+
+#ifndef AT_RX_BUFSIZE
+#define AT_RX_BUFSIZE           64                              /*ĬϽջС*/
+#endif
+
+#define AT_DATA_PROMPT          ">"                             /*ݷʾ*/
+
+#define AT_DEF_TIMEOUT          3000                            /*ĬӦʱ(ms)*/
+
+#ifndef AT_WORK_TIMEOUT
+#define AT_WORK_TIMEOUT         (150 * 1000)                    /*at_do_workĬŶ(ms)*/
+#endif
+
+/*
+ * ʱʱ(ms). ߳cfg.read_waitʱ, ֹ(at_suspend)
+ * 첽ʱ¼辭cfg.read_wake; δṩread_wakeʱӳٸʱ
+ */
+#ifndef AT_IDLE_WAIT
+#define AT_IDLE_WAIT            1000
+#endif
+
+#define AT_NO_TIMEOUT           0xFFFFFFFF                      /*at_obj_deadline: ޴ⳬʱ*/
+
+/*ȼ(ͬȼȵȵ) -------------------------------------------*/
+#define AT_PRIO_LOW             0
+#define AT_PRIO_NORMAL          1
+#define AT_PRIO_HIGH            2
+#define AT_PRIO_URGENT          3
 
 struct at_obj;                                                  /*AT*/
 
@@ -25,18 +65,39 @@ struct at_obj;                                                  /*AT
 typedef struct {
     const char *prefix;                                         //URCǰ׺
     void (*handler)(char *recvbuf, int size); 
+    char        endmark;                                        //(+IPD':'), 0 - 
 }utc_item_t;
     
 /*AT -------------------------------------------------------------------*/
 typedef struct {
     /*ݶдӿ -----------------------------------------------------------*/
-    unsigned int (*read)(void *buf, unsigned int len);          
+    unsigned int (*read)(void *buf, unsigned int len);          /*ΪNULLʱat_rx_pushд*/
     unsigned int (*write)(const void *buf, unsigned int len);
+    unsigned int (*writev)(const at_iovec_t *iov, int cnt);     /*ɢд(ѡ)*/
     void         (*debug)(const char *fmt, ...);
 	utc_item_t    *utc_tbl;                                     /*utc */
 	char          *urc_buf;                                     /*urcջ*/
 	unsigned short urc_tbl_count;
 	unsigned short urc_bufsize;                                 /*urcС*/
+    /*URCǰ׺(ѡ, ΪNULLʱ˳ƥ) ---------------------------*/
+    at_prefix_node_t *urc_nodes;                                /*ڵ*/
+    unsigned short   urc_node_count;                            /*ڵ*/
+    /*ջλ(ѡ, ΪNULLʱʹڲAT_RX_BUFSIZEֽڻ) ---------*/
+    unsigned char    *rx_buf;
+    unsigned short   rx_bufsize;
+    /*¼(ѡ) ---------------------------------------------------------*/
+    unsigned int   (*read_wait)(void *buf, unsigned int len, unsigned int timeout);
+    void           (*read_wake)(void);                          /*ʹеread_wait(ѡ, ̵߳)*/
+    unsigned char    rx_notify;                                 /*յʱat_rx_notify*/
+    /*ս(ѡ, ΪNULLʱʹat_result_def, AT_MATCH_MAX-1) ---*/
+    const at_result_t *result_tbl;
+    unsigned char    result_count;
+    /*Ӧʱ(ѡ, lat_tblΪNULLʱtimeoutΪ0ʹAT_DEF_TIMEOUT) ----*/
+    at_lat_entry_t   *lat_tbl;                                  /*ʱͳƱ*/
+    unsigned char    lat_count;
+    unsigned int     tmo_min, tmo_max;                          /*Ӧʱ(ms)*/
+    unsigned int     work_timeout;                              /*at_do_workŶ, 0 - AT_WORK_TIMEOUT*/
+    unsigned int     *urc_hits;                                 /*URC(ѡ, URCȳ)*/
 }at_conf_t;
 
 /*ATӦ ---------------------------------------------------------------*/
@@ -52,29 +113,100 @@ typedef struct {
     const char    *matcher;                                     /*ƥ䴮*/
     char          *recvbuf;                                     /*ջ*/
     unsigned short bufsize;                                     /*ճ*/
-    unsigned int   timeout;                                     /*ʱʱ */    
+    unsigned int   timeout;                                     /*ʱʱ, 0 - Ӧ */    
+    at_lines_t    *lines;                                       /*Ӧнṹ(ѡ)*/
+    unsigned char  result;                                      /*: ս(at_result_class)*/
+    short          code;                                        /*: +CME/+CMS, -1 - */
 }at_respond_t;
 
+/*ͨȴ(ÿ߳һ, ṩ, ʹǰat_waiter_init) ---*/
+typedef struct {
+    at_sem_t                sem;                                /*Ŷӻź*/
+    unsigned int            requests;                           /**/
+    unsigned int            queued;                             /*ҪŶӵĴ*/
+    unsigned int            expired;                            /*Ŷӳڴ*/
+    unsigned int            wait_ms;                            /*ۼŶʱ(ms)*/
+    unsigned int            wait_max;                           /*Ŷʱ(ms)*/
+}at_waiter_t;
+
+/*ѡ ---------------------------------------------------------------*/
+typedef struct {
+    at_waiter_t            *waiter;                             /*̵߳ĵȴ, ΪNULL*/
+    unsigned int            deadline;                           /*Ŷ(ms), 0 - ͬӦʱ*/
+    unsigned char           prio;                               /*ȼAT_PRIO_xxx*/
+}at_req_opt_t;
+
+/*첽״̬ ---------------------------------------------------------------*/
+typedef enum {
+    AT_ASYNC_IDLE = 0,
+    AT_ASYNC_QUEUED,                                            /*Ŷ*/
+    AT_ASYNC_SENDING,                                           /*ڷ*/
+    AT_ASYNC_RUNNING,                                           /*ȴӦ*/
+    AT_ASYNC_DONE                                               /*(retЧ)*/
+}at_async_state;
+
+/*첽(ṩ, ʹǰat_async_init) -------------------------*/
+typedef struct at_async {
+    struct list_head        node;
+    const char             *cmd;                                /*(ǰ豣Ч)*/
+    at_respond_t           *resp;                               /*Ӧ(ǰ豣Ч)*/
+    void                  (*cb)(struct at_async *a);            /*ɻص(ִ߳), ΪNULL*/
+    void                   *param;                              /*û*/
+    at_sem_t                done;                               /*ź(at_async_wait)*/
+    volatile unsigned char  state;                              /*at_async_state*/
+    at_return               ret;                                /*ִн*/
+}at_async_t;
+
 /*ATҵ ---------------------------------------------------------------------*/
 typedef struct at_work_env{   
     struct at_obj *at;
 	void          *params;                                     
     unsigned int (*write)(const void *buf, unsigned int len);
-    unsigned int (*read)(void *buf, unsigned int len);
+    unsigned int (*read)(void *buf, unsigned int len);          /*cfg.read, ʹat_rx_pushʱΪNULL*/
+    unsigned int (*recv)(struct at_obj *at, void *buf, unsigned int len); /*ȡ(ֽշʽ)*/
     
 	void         (*printf)(struct at_obj *at, const char *frm, ...);
+    void         (*tmpl)(struct at_obj *at, const at_tmpl_t *t, const at_arg_t *args); /*ģ巢*/
 	at_return    (*wait_resp)(struct at_obj *at, const char *resp, unsigned int timeout);
     void         (*recvclr)(struct at_obj *at);                /*սջ*/
 }at_work_env_t;
 
+/*߳ ---------------------------------------------------------------*/
+typedef struct at_reader {
+    struct list_head        objs;                               /*AT*/
+    at_sem_t                lock;                               /**/
+    at_sem_t                event;                              /*¼*/
+    at_sem_t                idle;                               /*֪ͨ(ժʱȴ)*/
+    struct at_obj          *busy;                               /*Ķ()*/
+    unsigned char           idle_wait;                          /*ȴidle߳*/
+    unsigned short          count;                              /**/
+}at_reader_t;
+
 /*AT ---------------------------------------------------------------------*/
 typedef struct at_obj {
     struct list_head        node;
+    at_reader_t             *reader;                            /*߳*/
 	at_conf_t               cfg;   
     at_work_env_t           env;
-	at_sem_t                cmd_lock;                           /**/
+    at_sem_t                req_lock;                           /**/
+    struct list_head        req_q;                              /*ȴͨ(ȼ)*/
+    unsigned char           owned;                              /*ͨѱռ*/
 	at_sem_t                completed;                          /**/
+    at_sem_t                line_idle;                          /*URCн*/
+    at_sem_t                async_lock;                         /*첽*/
+    struct list_head        async_q;                            /*Ŷӵ첽*/
+    at_async_t * volatile   async_run;                          /*ռͨ첽*/
     at_respond_t            *resp;
+    unsigned int            resp_tmo;                           /*ǰӦʱ*/
+    at_lat_t                lat;                                /*ʱͳ*/
+    at_stats_t              stats;                              /*ͳ(ֱӶȡ)*/
+    unsigned int            tx_us;                              /*ʱ(us)*/
+    unsigned char           first_rx;                           /*ȴӦֽ*/
+    at_prefix_t             urc_idx;                            /*URCǰ׺*/
+    at_match_t              matcher;                            /*Ӧƥ*/
+    signed char             match_ok;                           /*ƥ䴮ƥ, -1 - */
+    at_ring_t               rx;                                 /*ջ*/
+    unsigned char           rx_def[AT_RX_BUFSIZE];
 	unsigned int            resp_timer;
 	unsigned int            urc_timer;
 	at_return               ret;
@@ -83,6 +215,15 @@ typedef struct at_obj {
 	unsigned char           wait   : 1;
 	unsigned char           suspend: 1;
     unsigned char           dowork : 1;
+    unsigned char           urc_indexed : 1;                    /*URCЧ*/
+    volatile unsigned char  rx_ready;                           /*ݴȡ*/
+    volatile unsigned char  line_wait;                          /*ȴURCн*/
+    char                    urc_endmarks[4];                    /*URCǼ*/
+    unsigned int            raw_left;                           /*ʣ೤*/
+    at_sink_t               raw_sink;
+    void                    *raw_param;
+    void                    (*wake)(void *param);               /*ⲿ¼ѭѽӿ(ѡ)*/
+    void                    *wake_param;
 }at_obj_t;
 
 typedef int (*at_work)(at_work_env_t *);
@@ -93,16 +234,63 @@ void at_obj_destroy(at_obj_t *at);
 
 bool at_obj_busy(at_obj_t *at);
 
+bool at_urc_update(at_obj_t *at, utc_item_t *tbl, unsigned short count); /*URC*/
+
 void at_suspend(at_obj_t *at);                                 /**/
  
 void at_resume(at_obj_t *at);                                  /*ָ*/
 
 at_return at_do_cmd(at_obj_t *at, at_respond_t *r, const char *cmd);
 
+at_return at_do_cmd_opt(at_obj_t *at, at_respond_t *r, const char *cmd, 
+                        const at_req_opt_t *opt);
+
+at_return at_do_cmd_tmpl(at_obj_t *at, at_respond_t *r, const at_tmpl_t *t, 
+                         const at_arg_t *args);
+
+void at_waiter_init(at_waiter_t *w);
+
+at_return at_send_data(at_obj_t *at, at_respond_t *r, const char *cmd, 
+                       const void *buf, unsigned int len);
+
+void at_recv_data(at_obj_t *at, unsigned int len, at_sink_t sink, void *param);
+
+/*첽 -------------------------------------------------------------------*/
+void at_async_init(at_async_t *a);
+
+bool at_do_cmd_async(at_obj_t *at, at_async_t *a, at_respond_t *r, const char *cmd,
+                     void (*cb)(at_async_t *a), void *param);
+
+bool at_async_done(at_async_t *a);
+
+at_return at_async_wait(at_async_t *a, unsigned int timeout);
+
 int at_split_respond_lines(char *recvbuf, char *lines[], int count);
 
 int at_do_work(at_obj_t *at, at_work work, void *params);      /*ִATҵ*/
 
+void at_rx_notify(at_obj_t *at);                               /*֪ͨ*/
+
+unsigned int at_rx_push(at_obj_t *at, const void *buf, unsigned int len); /*д*/
+
 void at_thread(void);                                          /*AT߳*/
+
+/*߳ģʽ ---------------------------------------------------------------*/
+void at_reader_init(at_reader_t *r);
+
+void at_reader_attach(at_reader_t *r, at_obj_t *at);
+
+void at_reader_detach(at_obj_t *at);
+
+at_reader_t *at_reader_attach_pool(at_reader_t *pool, int count, at_obj_t *at);
+
+void at_reader_run(at_reader_t *r);                            /*߳ѭ*/
+
+/*ⲿ¼ѭģʽ -----------------------------------------------------------*/
+bool at_obj_process(at_obj_t *at, bool readable);
+
+unsigned int at_obj_deadline(at_obj_t *at);
+
+void at_obj_set_wake(at_obj_t *at, void (*wake)(void *param), void *param);
         
 #endif
@@ -21,14 +21,16 @@
 /*ATCOMM work type -----------------------------------------------------------*/
 #define AT_TYPE_WORK       0                             /* --------------*/
 #define AT_TYPE_CMD        1                             /*׼ ----------*/  
+#define AT_TYPE_SINGLLINE  2                             /* ----------*/
 #define AT_TYPE_MULTILINE  3                             /* ----------*/
-#define AT_TYPE_SINGLLINE  4                             /* ----------*/
+#define AT_TYPE_DATA       4                             /*ݷ ----------*/
+#define AT_TYPE_JOB        5                             /*Эҵ ----------*/
 
 typedef int (*base_work)(at_obj_t *at, ...);
 
 static void at_send_line(at_obj_t *at, const char *fmt, va_list args);
 
-static const inline at_core_conf_t *__get_adapter(at_obj_t *at) 
+static inline const at_obj_conf_t *__get_adapter(at_obj_t *at) 
 {
     return &at->cfg;
 }
@@ -37,12 +39,44 @@ static bool is_timeout(at_obj_t *at, unsigned int ms)
 {
     return AT_IS_TIMEOUT(at->resp_timer, ms);
 }
+
+/*
+ * @brief   λʱ
+ */
+static void reset_timer(at_obj_t *at)
+{
+    at->resp_timer = at_get_ms();
+}
 /*
  * @brief   
  */
 static void send_data(at_obj_t *at, const void *buf, unsigned int len)
 {
     at->cfg.write(buf, len);
+    at->stats.tx_bytes += len;
+}
+
+/*
+ * @brief   ɢд(writevӿʱϲд, ʱֶд)
+ */
+static void send_iov(at_obj_t *at, const at_iovec_t *iov, int cnt)
+{
+    char buf[MAX_AT_CMD_LEN + 2];
+    unsigned int len = 0;
+    int i;
+    for (i = 0; i < cnt; i++)
+        len += iov[i].len;
+    if (at->cfg.writev != NULL) {
+        at->cfg.writev(iov, cnt);
+        at->stats.tx_bytes += len;
+    } else if (len <= sizeof(buf)) {
+        for (len = 0, i = 0; i < cnt; len += iov[i++].len)
+            memcpy(buf + len, iov[i].base, iov[i].len);
+        send_data(at, buf, len);
+    } else {
+        for (i = 0; i < cnt; i++)
+            send_data(at, iov[i].base, iov[i].len);
+    }
 }
 
 /*
@@ -77,6 +111,60 @@ static char *get_recv_buf(at_obj_t *at)
 static void recv_buf_clear(at_obj_t *at)
 {
     at->rcv_cnt = 0;
+    at->matched = -1;
+    at->result  = AT_RESULT_NONE;
+    at->code    = -1;
+    at_match_restart(&at->matcher);
+    at_lines_reset(&at->lines);
+}
+
+/*
+ * @brief   ģ巢һ(ʱʽ)
+ */
+static void send_tmpl(at_obj_t *at, const at_tmpl_t *t, const at_arg_t *args)
+{
+    at_iovec_t iov[AT_TMPL_IOV_MAX];
+    char num[AT_TMPL_NUM_SIZE];
+    int cnt = at_tmpl_render(t, args, iov, num);
+    recv_buf_clear(at);     //սջ
+    at->tx_us    = at_get_us();
+    at->first_rx = 1;
+    send_iov(at, iov, cnt);
+}
+
+/*
+ * @brief   ȡս
+ */
+static const at_result_t *result_table(at_obj_t *at, int *count)
+{
+    if (at->cfg.result_tbl == NULL) {
+        *count = AT_RESULT_DEF_COUNT;
+        return at_result_def;
+    }
+    *count = at->cfg.result_count;
+    return at->cfg.result_tbl;
+}
+
+/*
+ * @brief   Ӧƥ䴮(ƥ䴮 + ս)
+ * @note    ƥat->matched: 0 - ƥɹ, 1 - ִд(at->result), 
+ *          -1 - δƥ
+ */
+static void match_begin(at_obj_t *at, const char *matcher)
+{
+    const at_result_t *tbl;
+    int i, n, count;
+    at_match_reset(&at->matcher);
+    at->match_ok = at_match_add(&at->matcher, matcher);  //ƥ䴮-1
+    tbl = result_table(at, &count);
+    for (i = 0; i < count; i++) {
+        if ((n = strlen(tbl[i].code)) > 0)
+            at_match_add_flags(&at->matcher, tbl[i].code, AT_MATCH_BOL |
+                               (tbl[i].code[n - 1] == ':' ? AT_MATCH_EOL : 0));
+    }
+    at->matched = -1;
+    at->result  = AT_RESULT_NONE;
+    at->code    = -1;
 }
 
 /*ǰִ*/
@@ -98,11 +186,16 @@ static bool at_isabort(at_obj_t *at)
 static void do_at_callbatk(at_obj_t *a, at_item_t *i, at_callbatk_t cb, at_return ret)
 {
     at_response_t r;
+    a->stats.cmd[ret]++;
     if (cb) {
         r.param   = i->param;
         r.recvbuf = get_recv_buf(a);
         r.recvcnt = get_recv_count(a);
         r.ret     = ret;       
+        r.lines   = &a->lines;
+        r.result  = a->result;
+        r.code    = a->code;
+        at_lines_finish(&a->lines, r.recvbuf, r.recvcnt, false);
         cb(&r);
     }
 }
@@ -111,35 +204,166 @@ static void do_at_callbatk(at_obj_t *a, at_item_t *i, at_callbatk_t cb, at_retur
  * @brief       AT
  * @param[in]   cfg   - ATӦ
  */
-void at_core_init(at_obj_t *at, const at_core_conf_t cfg)
+void at_obj_init(at_obj_t *at, const at_obj_conf_t cfg)
 {
     at_env_t *e;
+    at_item_t *tbl;
+    int i;
     at->cfg  = cfg;
     e = &at->env;    
     at->rcv_cnt = 0;
+    at->urc_cnt = 0;
+    at->cursor  = NULL;
+    if (cfg.rx_buf != NULL)
+        at_ring_init(&at->rx, cfg.rx_buf, cfg.rx_bufsize);
+    else
+        at_ring_init(&at->rx, at->rx_def, sizeof(at->rx_def));
+    at_match_reset(&at->matcher);
+    at->matched = -1;
+    at_lines_reset(&at->lines);
+    at_lat_init(&at->lat, cfg.lat_tbl, cfg.lat_count, cfg.tmo_min, cfg.tmo_max);
+    at_stats_clear(&at->stats);
+    at->first_rx = 0;
+    
+    INIT_LIST_HEAD(&at->ls_ready);
+    INIT_LIST_HEAD(&at->ls_idle);
+    if (cfg.item_tbl != NULL && cfg.item_count > 0) {
+        tbl = cfg.item_tbl;
+        at->item_total = cfg.item_count;
+    } else {
+        tbl = at->tbl;
+        at->item_total = sizeof(at->tbl) / sizeof(at->tbl[0]);
+    }
+    for (i = 0; i < at->item_total; i++)
+        list_add_tail(&tbl[i].node, &at->ls_idle);
+    at->item_used     = 0;
+    at->item_peak     = 0;
+    at->item_rejected = 0;
+    at->item_starved  = 0;
+    at->idle_wait     = 0;
     
+    at_urc_update(at, cfg.utc_tbl, cfg.urc_tbl_count);
+    
+    e->reset_timer = reset_timer;
     e->is_timeout = is_timeout;
     e->printf  = print;
+    e->tmpl    = send_tmpl;
     e->recvbuf = get_recv_buf;
     e->recvclr = recv_buf_clear;
     e->recvlen = get_recv_count;
     e->find    = search_string;
     e->abort   = at_isabort;
 }
-/*ҵ*/
-static bool add_work(at_obj_t *at, void *params, void *info, int type)
+/*
+ * @brief       ȡҵ
+ * @return      NULL - ҵҲ
+ */
+static at_item_t *item_get(at_obj_t *at)
 {
     at_item_t *i;
-    if (list_empty(&at->ls_idle))                       //޿at_item
+    if (!list_empty(&at->ls_idle)) {
+        i = list_first_entry(&at->ls_idle, at_item_t, node);
+    } else if (at->cfg.item_alloc != NULL && at->item_total < 0xFFFF &&
+               (i = at->cfg.item_alloc()) != NULL) {
+        at->item_total++;                               //ҵ
+        INIT_LIST_HEAD(&i->node);
+    } else {
+        at->item_rejected++;
+        at->item_starved = 1;
         return NULL;
-    i = list_first_entry(&at->ls_idle, at_item_t, node);//ӿȡҵ
+    }
+    if (++at->item_used > at->item_peak)
+        at->item_peak = at->item_used;
+    return i;
+}
+
+/*
+ * @brief       ͷҵ
+ */
+static void item_put(at_obj_t *at, at_item_t *i)
+{
+    list_move_tail(&i->node, &at->ls_idle);
+    at->item_used--;
+    if (at->item_starved) {
+        at->item_starved = 0;
+        if (at->cfg.item_ready)
+            at->cfg.item_ready();
+    }
+}
+
+/*ҵ*/
+static bool add_work(at_obj_t *at, void *params, void *info, int type, int prio)
+{
+    at_item_t *i;
+    if ((i = item_get(at)) == NULL)                     //޿at_item
+        return false;
     i->info  = (void *)info;
     i->param = (void *)params;
     i->state = AT_STATE_WAIT;
     i->type  = type;
     i->abort = 0;
+    i->nobatch = 0;
+    i->prio  = prio < AT_PRIO_LOW ? AT_PRIO_LOW :       //prioΪ2λֶ, Խֵ
+               prio > AT_PRIO_URGENT ? AT_PRIO_URGENT : prio;
+    i->sleep = 0;
+    i->stamp = at_get_ms();
+    if (type == AT_TYPE_JOB) {
+        memset(&i->job, 0, sizeof(i->job));
+        i->job.at     = at;
+        i->job.params = params;
+    }
     list_move_tail(&i->node, &at->ls_ready);            //
-    return i != 0;    
+    at->idle_wait = 0;
+    return true;
+}
+
+/*
+ * @brief       ѡȡҵ
+ * @details     Чȼ(ȼ + ȴʱ/AT_PRIO_AGING)ѡȡ, ͬȺ˳,
+ *              ѡеҵƵ(ȼҵȴ㹻Ҳᱻִ);
+ *              δڵЭҵ, ֹҵ(/óеЭҵ)ֱӻ
+ * @return      ѡеҵ, NULL - ҵ(¼絽ʱ)
+ */
+static at_item_t *pick_ready(at_obj_t *at)
+{
+    at_item_t *it, *n, *best = NULL;
+    unsigned int now = at_get_ms(), eff, best_eff = 0, wake = 0;
+    bool sleeping = false;
+    list_for_each_entry_safe(it, n, &at->ls_ready, node) {
+        if (it->abort) {
+            at->stats.cmd[AT_RET_ABORT]++;
+            item_put(at, it);
+            continue;
+        }
+        if (it->sleep && (int)(it->job.timer - now) > 0) {
+            if (!sleeping || (int)(it->job.timer - wake) < 0)
+                wake = it->job.timer;
+            sleeping = true;
+            continue;
+        }
+        eff = it->prio + (now - it->stamp) / AT_PRIO_AGING;
+        if (best == NULL || eff > best_eff) {
+            best     = it;
+            best_eff = eff;
+        }
+    }
+    if (best == NULL) {
+        at->idle_until = wake;
+        at->idle_wait  = 1;
+        return NULL;
+    }
+    best->sleep = 0;
+    list_move(&best->node, &at->ls_ready);
+    return best;
+}
+
+/*
+ * @brief       ¼ʱ
+ * @param[in]   timeout - ʱ(Գʱʱ)
+ */
+static void latency_update(at_obj_t *at, const char *cmd, bool timeout)
+{
+    at_lat_add(&at->lat, cmd, timeout ? at->resp_tmo : at_get_ms() - at->resp_timer);
 }
 
 /*
@@ -148,7 +372,94 @@ static bool add_work(at_obj_t *at, void *params, void *info, int type)
 static int do_work_handler(at_obj_t *at)
 {
     at_item_t *i = at->cursor;
-    return ((int (*)(at_env_t *e))i->info)(i->param);
+    return ((int (*)(at_env_t *e))i->info)(&at->env);
+}
+
+/*
+ * @brief  ִЭҵ
+ * @details óʱҵŻؾβ, ͨҵ
+ */
+static int do_job_handler(at_obj_t *at)
+{
+    at_item_t *i = at->cursor;
+    switch (((int (*)(at_job_t *j))i->info)(&i->job)) {
+    case AT_JOB_WAITING:
+        return 0;
+    case AT_JOB_SLEEPING:
+        i->sleep = 1;                                 /* fall through */
+    case AT_JOB_YIELDED:
+        i->stamp = at_get_ms();                       //ͬȼҵִ
+        list_move_tail(&i->node, &at->ls_ready);
+        at->cursor = NULL;
+        return 0;
+    default:
+        return 1;
+    }
+}
+
+/*
+ * @brief       Эҵ(֮ʹat_job_respȴӦ)
+ * @param[in]   matcher - Ӧƥ䴮, NULL - "OK"
+ * @param[in]   timeout - Ӧʱ(ms), 0 - ʷʱӦ
+ */
+void at_job_send(at_job_t *j, const char *matcher, unsigned int timeout, const char *fmt, ...)
+{
+    at_obj_t *at = j->at;
+    va_list args;
+    match_begin(at, matcher != NULL ? matcher : "OK");
+    at->resp_tmo = timeout ? timeout : at_lat_timeout(&at->lat, fmt, 3000, 0);
+    j->cmd = fmt;
+    reset_timer(at);
+    va_start(args, fmt);
+    at_send_line(at, fmt, args);
+    va_end(args);
+}
+
+/*
+ * @brief       Эҵģ巢(֮ʹat_job_respȴӦ)
+ */
+void at_job_send_tmpl(at_job_t *j, const char *matcher, unsigned int timeout,
+                      const at_tmpl_t *t, const at_arg_t *args)
+{
+    at_obj_t *at = j->at;
+    match_begin(at, matcher != NULL ? matcher : "OK");
+    at->resp_tmo = timeout ? timeout : at_lat_timeout(&at->lat, t->fmt, 3000, 0);
+    j->cmd = t->fmt;
+    reset_timer(at);
+    send_tmpl(at, t, args);
+}
+
+/*
+ * @brief       ЭҵȴӦ
+ * @return      true - (j->retΪ), false - ȴ
+ */
+bool at_job_resp(at_job_t *j)
+{
+    at_obj_t *at = j->at;
+    if (at->matched >= 0)
+        j->ret = at->matched ? AT_RET_ERROR : AT_RET_OK;
+    else if (AT_IS_TIMEOUT(at->resp_timer, at->resp_tmo))
+        j->ret = AT_RET_TIMEOUT;
+    else
+        return false;
+    at->stats.cmd[j->ret]++;
+    latency_update(at, j->cmd, j->ret == AT_RET_TIMEOUT);
+    return true;
+}
+
+/*
+ * @brief       Эҵȴгָ(j->timerʱ)
+ * @return      true - (j->retΪ), false - ȴ
+ */
+bool at_job_match(at_job_t *j, const char *expect, unsigned int timeout)
+{
+    if (search_string(j->at, expect) != NULL)
+        j->ret = AT_RET_OK;
+    else if (AT_IS_TIMEOUT(j->timer, timeout))
+        j->ret = AT_RET_TIMEOUT;
+    else
+        return false;
+    return true;
 }
 
 /*******************************************************************************
@@ -160,23 +471,25 @@ static int do_cmd_handler(at_obj_t *a)
 {
     at_item_t *i = a->cursor;
     at_env_t  *e = &a->env;
-    const at_respond_t *c = (at_respond_t *)i->info;
+    const at_cmd_t *c = (at_cmd_t *)i->info;
     switch(e->state) {
     case 0:  /*״̬ ------------------------------------------------------*/                              
         c->sender(e);
         e->state++;
         e->reset_timer(a);
         e->recvclr(a);
+        match_begin(a, c->matcher);
     break;
     case 1: /*״̬ ------------------------------------------------------*/ 
-        if (search_string(a, c->matcher)) {                      	
+        if (a->matched == 0) {                      	
             do_at_callbatk(a, i, c->cb, AT_RET_OK);
             return true;
-        } else if (search_string(a, "ERROR")) {    
+        } else if (a->matched == 1) {    
             if (++e->i >= c->retry) {
                 do_at_callbatk(a, i, c->cb, AT_RET_ERROR);
                 return true;
             }
+            a->stats.retries++;
             e->state = 2;                             /*֮ʱһʱ*/                
             e->reset_timer(a);                        /*öʱ*/
         } else if (e->is_timeout(a, c->timeout))  {   
@@ -184,6 +497,7 @@ static int do_cmd_handler(at_obj_t *a)
                 do_at_callbatk(a, i, c->cb, AT_RET_TIMEOUT);
                 return true;
             }                
+            a->stats.retries++;
             e->state = 0;                             /*һ״̬*/
         }
     break; 
@@ -197,6 +511,144 @@ static int do_cmd_handler(at_obj_t *a)
     return false;
 }
 
+/*
+ * @brief       ȡɺϲ("AT+CREG?""+CREG")
+ * @return      Ƴ, 0 - ɺϲ(չǶ)
+ * @note        ֻϲ'?'βĶ, "AT+CRESET""AT+CGATT=1"ִ/
+ *              и, ϲ
+ */
+static int batch_cmd_name(const char *cmd)
+{
+    int n;
+    if ((cmd[0] != 'A' && cmd[0] != 'a') || (cmd[1] != 'T' && cmd[1] != 't'))
+        return 0;
+    if (cmd[2] != '+' && cmd[2] != '^' && cmd[2] != '$' && cmd[2] != '%')
+        return 0;
+    for (n = 1; cmd[2 + n] != '\0' && cmd[2 + n] != '?'; n++) {
+        if (cmd[2 + n] == '=' || cmd[2 + n] == ';')
+            return 0;
+    }
+    if (cmd[2 + n] != '?' || cmd[3 + n] != '\0')
+        return 0;
+    return n > 1 ? n : 0;
+}
+
+/*
+ * @brief       ռɺϲĵ
+ * @details     ӵǰҵʼ, ڵĲѯ൥ϲΪһ
+ *              ("AT+CREG?;+CGATT?;+CEREG?"), ȲMAX_AT_CMD_LEN
+ * @return      ϲ
+ */
+static unsigned char batch_collect(at_obj_t *at)
+{
+    at_item_t *it = at->cursor;
+    unsigned char cnt = 0;
+    unsigned int len = 2;
+    while (cnt < AT_BATCH_MAX && it->type == AT_TYPE_SINGLLINE && !it->nobatch &&
+           it->prio == at->cursor->prio && batch_cmd_name((const char *)it->param) > 0) {
+        len += strlen((const char *)it->param) - 1;          /*ȥ"AT", ';'*/
+        if (len > MAX_AT_CMD_LEN - 1)
+            break;
+        cnt++;
+        if (it->node.next == &at->ls_ready)
+            break;
+        it = list_entry(it->node.next, at_item_t, node);
+    }
+    return cnt > 0 ? cnt : 1;
+}
+
+/*
+ * @brief       صϲִеĸ
+ * @details     ÿӦΪƿͷϢ("+CSQ: 20,99"), 
+ *              صڼĩβʱд'\0'
+ */
+static void batch_dispatch(at_obj_t *a)
+{
+    at_item_t *it = a->cursor;
+    char *buf = get_recv_buf(a), *p, *begin, *end, c;
+    const char *cmd;
+    at_response_t r;
+    int k, n;
+    for (k = 0; k < a->batch; k++) {
+        cmd   = (const char *)it->param;
+        n     = batch_cmd_name(cmd);
+        begin = end = NULL;
+        for (p = buf; *p != '\0'; p++) {                    /*ҸϢ*/
+            if ((p == buf || p[-1] == '\n') && strncmp(p, cmd + 2, n) == 0 &&
+                p[n] == ':') {
+                if (begin == NULL)
+                    begin = p;
+                end = p + strcspn(p, "\r\n");
+            }
+        }
+        if (begin == NULL)
+            begin = end = buf + get_recv_count(a);
+        if (it->info) {
+            c = *end;
+            *end = '\0';
+            r.param   = it->param;
+            r.recvbuf = begin;
+            r.recvcnt = end - begin;
+            r.ret     = AT_RET_OK;
+            r.lines   = NULL;
+            a->stats.cmd[AT_RET_OK]++;
+            r.result  = AT_RESULT_NONE;
+            r.code    = -1;
+            ((at_callbatk_t)it->info)(&r);
+            *end = c;
+        }
+        it = list_entry(it->node.next, at_item_t, node);
+    }
+}
+
+/*******************************************************************************
+ * @brief       ϲִ
+ * @details     ʱΪִ
+ * @param[in]   a - AT
+ * @return      0 - ֹ,0 - 
+ ******************************************************************************/
+static int send_batch_handler(at_obj_t *a)
+{
+    at_item_t *it;
+    at_env_t  *e = &a->env;
+    char buf[MAX_AT_CMD_LEN];
+    unsigned int len = 2;
+    int k;
+    switch(e->state) {
+    case 0:
+        memcpy(buf, "AT", 2);
+        for (k = 0, it = a->cursor; k < a->batch; k++) {
+            if (k > 0)
+                buf[len++] = ';';
+            strcpy(buf + len, (const char *)it->param + 2);
+            len += strlen(buf + len);
+            it = list_entry(it->node.next, at_item_t, node);
+        }
+        e->printf(a, "%s", buf);
+        e->recvclr(a);
+        match_begin(a, "OK");
+        e->reset_timer(a);
+        e->state++;
+    break;
+    case 1:
+        if (a->matched == 0) {
+            batch_dispatch(a);
+            return true;
+        } else if (a->matched == 1 || e->is_timeout(a, 3000)) {
+            for (k = 0, it = a->cursor; k < a->batch; k++) {
+                it->nobatch = 1;                          /*ִֵ*/
+                it = list_entry(it->node.next, at_item_t, node);
+            }
+            a->batch = 1;
+            e->state = 0;
+        }
+    break;
+    default:
+        e->state = 0;
+    }
+    return false;
+}
+
 /*******************************************************************************
  * @brief       
  * @param[in]   a - AT
@@ -209,34 +661,45 @@ static int send_signlline_handler(at_obj_t *a)
     const char *cmd  = (const char *)i->param;
     at_callbatk_t cb = (at_callbatk_t)i->info;
     
+    if (a->batch > 1)
+        return send_batch_handler(a);
     switch(e->state) {
     case 0:  /*״̬ ------------------------------------------------------*/                              
-        e->printf(a, cmd);
+        e->printf(a, "%s", cmd);
         e->state++;
         e->reset_timer(a);
         e->recvclr(a);
+        match_begin(a, "OK");
+        a->resp_tmo = a->lat.tbl ? at_lat_timeout(&a->lat, cmd, 3000, e->i) : 
+                      3000 + (unsigned int)e->i * 2000;
     break;
     case 1: /*״̬ ------------------------------------------------------*/ 
-        if (search_string(a, "OK")) {                      	
+        if (a->matched == 0) {                      	
+            latency_update(a, cmd, false);
             do_at_callbatk(a, i, cb, AT_RET_OK);
             return true;
-        } else if (search_string(a, "ERROR")) {
+        } else if (a->matched == 1) {
+            latency_update(a, cmd, false);
             if (++e->i >= 3) {
                 do_at_callbatk(a, i, cb, AT_RET_ERROR);
                 return true;
             }
+            a->stats.retries++;
             e->state = 2;                             /*֮ʱһʱ*/                
             e->reset_timer(a);                        /*öʱ*/
-        } else if (e->is_timeout(a, 3000 + e->i * 2000))  {   
+            a->resp_tmo = at_lat_backoff(&a->lat, cmd, 500, e->i - 1);
+        } else if (e->is_timeout(a, a->resp_tmo))  {   
+            latency_update(a, cmd, true);
             if (++e->i >= 3) {
                 do_at_callbatk(a, i, cb, AT_RET_TIMEOUT);
                 return true;
             }                
+            a->stats.retries++;
             e->state = 0;                             /*һ״̬*/
         }            
     break; 
     case 2:
-        if (e->is_timeout(a, 500))
+        if (e->is_timeout(a, a->resp_tmo))
             e->state = 0;                             /*سʼ״̬*/    
     break;
     default: 
@@ -261,50 +724,176 @@ static int send_multiline_handler(at_obj_t *a)
             do_at_callbatk(a, i, cb, AT_RET_OK);
             return true;
         }
-        e->printf(a, "%s\r\n", cmds[e->i]);
+        e->printf(a, "%s", cmds[e->i]);
         e->recvclr(a);                               /**/
+        match_begin(a, "OK");
         e->reset_timer(a);
         e->state++;
+        a->resp_tmo = a->lat.tbl ? at_lat_timeout(&a->lat, cmds[e->i], 3000, 0) : 3000;
     break;
     case 1:
-        if (search_string(a, "OK")){         
+        if (a->matched == 0){         
+            latency_update(a, cmds[e->i], false);
             e->state = 0;
             e->i++;
-            e->i     = 0;
-        } else if (search_string(a, "ERROR")) {
+            e->j     = 0;
+        } else if (a->matched == 1) {
+            latency_update(a, cmds[e->i], false);
             if (++e->j >= 3) {
                 do_at_callbatk(a, i, cb, AT_RET_ERROR);
                 return true;
             }
+            a->stats.retries++;
             e->state = 2;                             /*֮ʱһʱ*/                
             e->reset_timer(a);                        /*öʱ*/            
-        } else if (e->is_timeout(a, 3000)) {
+            a->resp_tmo = at_lat_backoff(&a->lat, cmds[e->i], 500, e->j - 1);
+        } else if (e->is_timeout(a, a->resp_tmo)) {
+            latency_update(a, cmds[e->i], true);
             do_at_callbatk(a, i, cb, AT_RET_TIMEOUT);
             return true;
         }       
     break;
+    case 2:
+        if (e->is_timeout(a, a->resp_tmo))
+            e->state = 0;                             /*سʼ״̬*/    
+    break;
     default: 
         e->state = 0;    
     }
     return 0;
 }
 
+/*******************************************************************************
+ * @brief       ݷ( -> ʾ">" ->  -> )
+ * @param[in]   a - AT
+ * @return      0 - ֹ,0 - 
+ ******************************************************************************/
+static int send_data_handler(at_obj_t *a)
+{
+    at_item_t *i = a->cursor;
+    at_env_t  *e = &a->env;
+    const at_data_t *d = (const at_data_t *)i->info;
+    switch(e->state) {
+    case 0:  /* ------------------------------------------------------*/
+        e->printf(a, "%s", d->cmd);
+        e->recvclr(a);
+        match_begin(a, AT_DATA_PROMPT);
+        e->reset_timer(a);
+        e->state++;
+    break;
+    case 1:  /*ȴʾ ----------------------------------------------------*/
+    case 2:  /*ȴ ------------------------------------------------------*/
+        if (a->matched == 0 && e->state == 1) {
+            e->recvclr(a);
+            match_begin(a, d->matcher ? d->matcher : "OK");
+            send_data(a, d->buf, d->len);             /*ʾ֮鷢*/
+            e->reset_timer(a);
+            e->state++;
+        } else if (a->matched == 0) {
+            do_at_callbatk(a, i, d->cb, AT_RET_OK);
+            return true;
+        } else if (a->matched == 1) {
+            do_at_callbatk(a, i, d->cb, AT_RET_ERROR);
+            return true;
+        } else if (e->is_timeout(a, d->timeout)) {
+            do_at_callbatk(a, i, d->cb, AT_RET_TIMEOUT);
+            return true;
+        }
+    break;
+    default: 
+        e->state = 0;
+    }
+    return false;
+}
+
+/*
+ * @brief       ʽݽ
+ */
+static void line_sink(void *param, const void *buf, unsigned int len)
+{
+    send_data((at_obj_t *)param, buf, len);
+}
+
 /*
  * @brief       
+ * @details     MAX_AT_CMD_LEN + 2ֽڵķֿ黺д, Ȳ,
+ *              (з)һд.
  * @param[in]   fmt    - ʽ
  * @param[in]   args   - б
  */
 static void at_send_line(at_obj_t *at, const char *fmt, va_list args)
 {
-    char buf[MAX_AT_CMD_LEN];
-    int len;
-    const at_core_conf_t *adt = __get_adapter(at);
-    len = vsnprintf(buf, sizeof(buf), fmt, args);
-
+    char buf[MAX_AT_CMD_LEN + 2];
+    at_stream_t s;
     recv_buf_clear(at);     //սջ
-    send_data(at, buf, len);
-    send_data(at, "\r\n", 2);
+    at->tx_us    = at_get_us();
+    at->first_rx = 1;
+    at_stream_init(&s, buf, sizeof(buf), line_sink, at);
+    at_stream_vprintf(&s, fmt, args);
+    at_stream_write(&s, "\r\n", 2);
+    at_stream_flush(&s);
+    at->stats.tx_truncated += s.truncated;
 }
+/*
+ * @brief       URCؽǰ׺
+ * @param[in]   tbl   - URC(ɴat->cfg.utc_tbl, ޸ĺؽ)
+ * @param[in]   count - 
+ * @return      false - ڵز, ˻Ϊƥ
+ */
+bool at_urc_update(at_obj_t *at, utc_item_t *tbl, unsigned short count)
+{
+    unsigned short i, k = 0;
+    at->urc_indexed       = 0;
+    at->cfg.utc_tbl       = tbl;
+    at->cfg.urc_tbl_count = count;
+    for (i = 0; i < count; i++) {                     /*ռ*/
+        if (tbl[i].endmark != '\0' && k < sizeof(at->urc_endmarks) - 1 &&
+            memchr(at->urc_endmarks, tbl[i].endmark, k) == NULL)
+            at->urc_endmarks[k++] = tbl[i].endmark;
+    }
+    at->urc_endmarks[k] = '\0';
+    if (at->cfg.urc_nodes == NULL)
+        return false;
+    at_prefix_init(&at->urc_idx, at->cfg.urc_nodes, at->cfg.urc_node_count);
+    for (i = 0; i < count; i++) {
+        if (!at_prefix_add(&at->urc_idx, tbl[i].prefix, i))
+            return false;
+    }
+    at->urc_indexed = 1;
+    return true;
+}
+
+/*
+ * @brief       URC
+ * @return      ƥ(˳һƥǰ׺), NULL - ƥ
+ */
+static utc_item_t *urc_lookup(at_obj_t *at, const char *urc, unsigned int size)
+{
+    int i, n;
+    utc_item_t *tbl = at->cfg.utc_tbl;
+    if (at->urc_indexed) {
+        i = at_prefix_match(&at->urc_idx, urc, size);
+        return i < 0 ? NULL : &tbl[i];
+    }
+    for (i = 0; i < at->cfg.urc_tbl_count; i++) {
+        n = strlen(tbl->prefix);
+        if (n > 0 && (unsigned int)n <= size && memcmp(urc, tbl->prefix, n) == 0)
+            return tbl;
+        tbl++;
+    }
+    return NULL;
+}
+
+/*
+ * @brief       URC
+ */
+static void urc_count(at_obj_t *at, utc_item_t *item)
+{
+    at->stats.urc_lines++;
+    if (at->cfg.urc_hits != NULL)
+        at->cfg.urc_hits[item - at->cfg.utc_tbl]++;
+}
+
 /*
  * @brief       urc 
  * @param[in]   urc
@@ -312,44 +901,118 @@ static void at_send_line(at_obj_t *at, const char *fmt, va_list args)
  */
 static void urc_handler_entry(at_obj_t *at, char *urc, unsigned int size)
 {
-    int i, n;
-    utc_item_t *tbl = at->cfg.utc_tbl;
-    for (i = 0; i < at->cfg.urc_tbl_count; i++){
-    n = strlen(tbl->prefix);
-    if (strncmp(urc, tbl->prefix, n) == 0)
-        tbl[i].handler(urc, size);
+    utc_item_t *item = urc_lookup(at, urc, size);
+    if (item != NULL) {
+        urc_count(at, item);
+        item->handler(urc, size);
+    }
+}
+
+/*
+ * @brief       ׷ݵURCл
+ */
+static void urc_append(at_obj_t *at, const char *buf, unsigned int n)
+{
+    if (at->urc_cnt + n >= at->cfg.urc_bufsize) {     //
+        at->urc_cnt = 0;
+        at->stats.urc_overflow++;
+        at->stats.urc_dropped++;
+        if (n >= at->cfg.urc_bufsize)
+            n = 0;
     }
+    memcpy(at->cfg.urc_buf + at->urc_cnt, buf, n);
+    at->urc_cnt += n;
 }
 
 /*
  * @brief       urc մ
- * @param[in]   buf  - ݻ
- * @return      none
+ * @param[in]   buf  - ݻ(λڵ)
+ * @return      Ѵ, URC(at_recv_data)ʱ, 
+ *              ݲٰд
  */
-static void urc_recv_process(at_obj_t *at, char *buf, unsigned int size)
+static unsigned int urc_recv_process(at_obj_t *at, char *buf, unsigned int size)
 {
-    char *urc_buf;	
-    unsigned short urc_size;
+    char *urc_buf, *end, *s, *start = buf, c;	
+    unsigned int n;
+    utc_item_t *item;
     urc_buf  = (char *)at->cfg.urc_buf;
-    urc_size = at->cfg.urc_bufsize;	
-    if (size == 0 && at->urc_cnt > 0) {
-        if (AT_IS_TIMEOUT(at->urc_timer, 2000)){
+    if (size == 0) {
+        if (at->urc_cnt > 0 && AT_IS_TIMEOUT(at->urc_timer, 2000)){
+            urc_buf[at->urc_cnt] = '\0';
             urc_handler_entry(at, urc_buf, at->urc_cnt);
-            at->rcv_cnt = 0;
+            at->urc_cnt = 0;
         }
-    } else {
-        at->urc_timer = at_get_ms();
-        while (size--) {
-            if (*buf == '\n') {
-                urc_buf[at->urc_cnt] = '\0';
-                urc_handler_entry(at, urc_buf, at->urc_cnt);
+        return 0;
+    }
+    at->urc_timer = at_get_ms();
+    for (end = buf + size, s = buf; s < end; s++) {
+        c = *s;
+        if (c == '\n') {
+            n = s - buf;
+            if (at->urc_cnt == 0) {                   //ڻ,ԭش
+                if (n > 0) {
+                    *s = '\0';
+                    urc_handler_entry(at, buf, n);
+                    *s = c;
+                }
             } else {
-            urc_buf[at->urc_cnt++] = *buf++;
-            if (at->urc_cnt >= urc_size)
-              at->urc_cnt = 0;
+                urc_append(at, buf, n);
+                urc_buf[at->urc_cnt] = '\0';
+                if (at->urc_cnt > 0)
+                    urc_handler_entry(at, urc_buf, at->urc_cnt);
+                at->urc_cnt = 0;
             }
+            buf = s + 1;
+        } else if (c != '\0' && strchr(at->urc_endmarks, c) != NULL) {
+            if (at->urc_cnt > 0) {                    //ǻнURC("+IPD,5:")
+                urc_append(at, buf, s + 1 - buf);
+                buf = s + 1;
+                item = urc_lookup(at, urc_buf, at->urc_cnt);
+            } else
+                item = urc_lookup(at, buf, s + 1 - buf);
+            if (item == NULL || item->endmark != c)
+                continue;
+            urc_append(at, buf, s + 1 - buf);
+            buf = s + 1;
+            urc_buf[at->urc_cnt] = '\0';
+            urc_count(at, item);
+            item->handler(urc_buf, at->urc_cnt);
+            at->urc_cnt = 0;
+            if (at->raw_left > 0)                     //Ϊ
+                return s + 1 - start;
         }
     }
+    urc_append(at, buf, end - buf);
+    return size;
+}
+
+/*
+ * @brief       մ(, ׷'\0')
+ * @return      Ѵ
+ */
+static unsigned int raw_recv_process(at_obj_t *at, const void *buf, unsigned int size)
+{
+    if (size > at->raw_left)
+        size = at->raw_left;
+    at->raw_left -= size;
+    at->urc_timer = at_get_ms();
+    at->raw_sink(at->raw_param, buf, size);
+    return size;
+}
+
+/*
+ * @brief       
+ * @details     յlenֽԭsink, URCмӦƥ, 
+ *              "+IPD,<len>:"֮Ķ, һURCе
+ * @param[in]   len   - ճ
+ * @param[in]   sink  - ݽ(ܱε)
+ * @param[in]   param - sink
+ */
+void at_recv_data(at_obj_t *at, unsigned int len, at_sink_t sink, void *param)
+{
+    at->raw_sink  = sink;
+    at->raw_param = param;
+    at->raw_left  = sink != NULL ? len : 0;
 }
 
 /*
@@ -361,17 +1024,52 @@ static void resp_recv_process(at_obj_t *at, const char *buf, unsigned int size)
 {
     char *rcv_buf;
     unsigned short rcv_size;	
+    unsigned int n = size, end;
+    const char *s = buf;
+    const at_result_t *tbl;
+    int i, idx, count;
     
     rcv_buf  = (char *)at->cfg.rcv_buf;
     rcv_size = at->cfg.rcv_bufsize;
 
-    if (at->rcv_cnt + size >= rcv_size)         //
+    if (at->rcv_cnt + n >= rcv_size) {          //
         at->rcv_cnt = 0;
+        at->stats.rx_overflow++;
+        at_lines_reset(&at->lines);
+        if (n >= rcv_size) {                    //ֻ󲿷
+            s += n - rcv_size + 1;
+            n  = rcv_size - 1;
+        }
+    }
     
-    memcpy(rcv_buf + rcv_cnt, buf, size);
-    at->rcv_cnt += size;
+    memcpy(rcv_buf + at->rcv_cnt, s, n);
+    at->rcv_cnt += n;
     rcv_buf[at->rcv_cnt] = '\0';
-
+    
+    if (at->matched >= 0)
+        return;
+    if (at->first_rx) {                             //->ֽʱ
+        at->first_rx = 0;
+        at_stats_hist(at->stats.first_byte, at_get_us() - at->tx_us);
+    }
+    idx = at_match_feed(&at->matcher, buf, size, &n);//ʽƥ,ÿֻֽɨһ
+    if (idx < 0) {
+        at_lines_feed(&at->lines, rcv_buf, at->rcv_cnt);
+        return;
+    }
+    n   = size - n;
+    end = at->rcv_cnt > n ? at->rcv_cnt - n : 0;     //ĩβ
+    at_stats_hist(at->stats.final_result, at_get_us() - at->tx_us);
+    at->matched = idx != at->match_ok;
+    if (at->matched) {                              //ս(ִд)
+        tbl = result_table(at, &count);
+        for (i = 0; i < count && tbl[i].code != at->matcher.pat[idx].str; i++) {}
+        if (i < count)                              //ģʽһؽ
+            at->result = tbl[i].cls;
+        if (at->matcher.pat[idx].flags & AT_MATCH_EOL)
+            at->code = at_result_code(rcv_buf, end);
+    }
+    at_lines_finish(&at->lines, rcv_buf, end, true);//нṹֹĩβ
 }
 
 /*
@@ -382,7 +1080,35 @@ static void resp_recv_process(at_obj_t *at, const char *buf, unsigned int size)
  */
 bool at_do_work(at_obj_t *at, int (*work)(at_env_t *e), void *params)
 {
-    return add_work(at, params, (void *)work, AT_TYPE_WORK);
+    return at_do_work_prio(at, work, params, AT_PRIO_NORMAL);
+}
+
+/*
+ * @brief       ִATҵ(ָȼ)
+ * @param[in]   prio   - ȼ(AT_PRIO_LOW ~ AT_PRIO_URGENT)
+ */
+bool at_do_work_prio(at_obj_t *at, int (*work)(at_env_t *e), void *params, int prio)
+{
+    return add_work(at, params, (void *)work, AT_TYPE_WORK, prio);
+}
+
+/*
+ * @brief       ִЭҵ
+ * @param[in]   job    - ҵ(ʹAT_JOB_xxxд)
+ * @param[in]   params - ҵ(j->params)
+ */
+bool at_do_job(at_obj_t *at, int (*job)(at_job_t *j), void *params)
+{
+    return at_do_job_prio(at, job, params, AT_PRIO_NORMAL);
+}
+
+/*
+ * @brief       ִЭҵ(ָȼ)
+ * @param[in]   prio   - ȼ(AT_PRIO_LOW ~ AT_PRIO_URGENT)
+ */
+bool at_do_job_prio(at_obj_t *at, int (*job)(at_job_t *j), void *params, int prio)
+{
+    return add_work(at, params, (void *)job, AT_TYPE_JOB, prio);
 }
 
 /*
@@ -390,9 +1116,30 @@ bool at_do_work(at_obj_t *at, int (*work)(at_env_t *e), void *params)
  * @param[in]   a - AT
  * @param[in]   cmd   - cmd
  */
-bool at_do_cmd(at_obj_t *at, void *params, const at_respond_t *cmd)
+bool at_do_cmd(at_obj_t *at, void *params, const at_cmd_t *cmd)
+{
+    return at_do_cmd_prio(at, params, cmd, AT_PRIO_NORMAL);
+}
+
+/*
+ * @brief       ִATָ(ָȼ)
+ * @param[in]   prio   - ȼ(AT_PRIO_LOW ~ AT_PRIO_URGENT)
+ */
+bool at_do_cmd_prio(at_obj_t *at, void *params, const at_cmd_t *cmd, int prio)
+{
+    return add_work(at, params, (void *)cmd, AT_TYPE_CMD, prio);
+}
+
+/*
+ * @brief       (AT+CIPSEND=<n> -> ">" -> nֽ -> "SEND OK")
+ * @param[in]   a      - AT
+ * @param[in]   params - ص
+ * @param[in]   data   - ݷ
+ * @note        ڷ֮ǰ,dataݻʼЧ
+ */
+bool at_send_data(at_obj_t *at, void *params, const at_data_t *data)
 {
-    return add_work(at, params, (void *)cmd, AT_TYPE_CMD);
+    return add_work(at, params, (void *)data, AT_TYPE_DATA, AT_PRIO_NORMAL);
 }
 
 /*
@@ -404,7 +1151,17 @@ bool at_do_cmd(at_obj_t *at, void *params, const at_respond_t *cmd)
  */
 bool at_send_singlline(at_obj_t *at, at_callbatk_t cb, const char *singlline)
 {
-    return add_work(at, (void *)singlline, (void *)cb, AT_TYPE_SINGLLINE);
+    return at_send_singlline_prio(at, cb, singlline, AT_PRIO_NORMAL);
+}
+
+/*
+ * @brief       ͵AT(ָȼ)
+ * @param[in]   prio   - ȼ(AT_PRIO_LOW ~ AT_PRIO_URGENT)
+ */
+bool at_send_singlline_prio(at_obj_t *at, at_callbatk_t cb, const char *singlline,
+                            int prio)
+{
+    return add_work(at, (void *)singlline, (void *)cb, AT_TYPE_SINGLLINE, prio);
 }
 
 /*
@@ -416,7 +1173,17 @@ bool at_send_singlline(at_obj_t *at, at_callbatk_t cb, const char *singlline)
  */
 bool at_send_multiline(at_obj_t *at, at_callbatk_t cb, const char **multiline)
 {
-    return add_work(at, multiline, (void *)cb, AT_TYPE_MULTILINE);    
+    return at_send_multiline_prio(at, cb, multiline, AT_PRIO_NORMAL);
+}
+
+/*
+ * @brief       ͶAT(ָȼ)
+ * @param[in]   prio   - ȼ(AT_PRIO_LOW ~ AT_PRIO_URGENT)
+ */
+bool at_send_multiline_prio(at_obj_t *at, at_callbatk_t cb, const char **multiline,
+                            int prio)
+{
+    return add_work(at, multiline, (void *)cb, AT_TYPE_MULTILINE, prio);    
 }
 
 /*
@@ -426,59 +1193,151 @@ bool at_send_multiline(at_obj_t *at, at_callbatk_t cb, const char **multiline)
 void at_item_abort(at_item_t *i)
 {
 	i->abort = 1;
+    if (i->type == AT_TYPE_JOB)                     //еҵѡȡܻ
+        i->job.at->idle_wait = 0;
+}
+
+/*
+ * @brief       ȡҵͳ
+ * @param[out]  st - ͳϢ
+ */
+void at_pool_stats(at_obj_t *at, at_pool_stats_t *st)
+{
+    st->total    = at->item_total;
+    st->used     = at->item_used;
+    st->peak     = at->item_peak;
+    st->rejected = at->item_rejected;
 }
 
 /*
  * @brief       ATæж
  * @return      true - ATִָ
  */
-bool at_core_busy(at_obj_t *at)
+bool at_obj_busy(at_obj_t *at)
 {
     return !list_empty(&at->ls_ready);
 }
 
+/*
+ * @brief       ATҵ
+ */
+void at_suspend(at_obj_t *at)
+{
+    at->suspend = 1;
+}
+
+/*
+ * @brief       ָATҵ
+ */
+void at_resume(at_obj_t *at)
+{
+    at->suspend = 0;
+}
+
 /*******************************************************************************
  * @brief   ATҵ
  ******************************************************************************/
 static void at_work_manager(at_obj_t *at)
 {     
-    register at_item_t *cursor = at->cursor;
+    register at_item_t *cursor;
     at_env_t           *e      = &at->env;
     /*ͨù ---------------------------------------------------------*/
     static int (*const work_handler_table[])(at_obj_t *) = {
     	do_work_handler, 
         do_cmd_handler,
         send_signlline_handler,
-        send_multiline_handler
+        send_multiline_handler,
+        send_data_handler,
+        do_job_handler
     };       
     if (at->cursor == NULL) {    
         if (list_empty(&at->ls_ready))                   //Ϊ
             return;
+        if (at->idle_wait && (int)(at->idle_until - at_get_ms()) > 0)
+            return;                                      //ҵ
+        if ((at->cursor = pick_ready(at)) == NULL)
+            return;
+        at->batch  = at->cfg.batch ? batch_collect(at) : 1;
         e->i     = 0; 
         e->j     = 0;
         e->state = 0;
-        e->params = cursor->param;        
+        e->params = at->cursor->param;        
         e->recvclr(at);
         e->reset_timer(at);
-        at->cursor = list_first_entry(&at->ls_ready, at_item_t, node);
     }
+    cursor = at->cursor;
     /*ִ,뵽й ------------------------------------*/
-    if (work_handler_table[cursor->type](at) || cursor->abort) {
-    	list_move_tail(&at->cursor->node, &at->ls_idle);
+    if (work_handler_table[cursor->type](at)) {
+        while (--at->batch > 0)                          //ϲִе
+            item_put(at, list_entry(cursor->node.next, at_item_t, node));
+    	item_put(at, cursor);
+		at->cursor = NULL;
+    } else if (cursor->abort) {
+        at->stats.cmd[AT_RET_ABORT]++;
+    	item_put(at, cursor);
 		at->cursor = NULL;
     }
         
 }
+/*
+ * @brief       д(ж/DMAɻصֱӵ, cfg.read)
+ * @return      ʵд볤, λʱʣಿ(stats.rx_dropped)
+ * @note        ֻһ, at_poll_taskΪΨһ, ж
+ */
+unsigned int at_rx_push(at_obj_t *at, const void *buf, unsigned int len)
+{
+    unsigned int n = at_ring_put(&at->rx, buf, len);
+    if (n < len)
+        at->stats.rx_dropped += len - n;
+    return n;
+}
+
+/*
+ * @brief       ݽմ
+ * @details     ֱӶ뻷λ, ӦۻURCо
+ *              ڵݶϽ, еURCٸ
+ */
+static void rx_process(at_obj_t *at)
+{
+    unsigned char *p;
+    unsigned int len, n;
+    p = at_ring_wspan(&at->rx, &len);
+    if (len > 0 && __get_adapter(at)->read != NULL && //ΪNULLʱat_rx_pushд
+        (n = __get_adapter(at)->read(p, len)) > 0) {
+        at_ring_commit(&at->rx, n);
+        if (n == len) {                         //дĩβ,Ʋ
+            p = at_ring_wspan(&at->rx, &len);
+            if (len > 0)
+                at_ring_commit(&at->rx, __get_adapter(at)->read(p, len));
+        }
+    }
+    p = at_ring_rspan(&at->rx, &len);
+    if (len == 0) {
+        urc_recv_process(at, NULL, 0);          //URCʱ
+        if (at->raw_left > 0 && AT_IS_TIMEOUT(at->urc_timer, 1000))
+            at->raw_left = 0;                   //ճʱ
+        return;
+    }
+    do {
+        if (at->raw_left > 0) {                 //ģʽ
+            n = raw_recv_process(at, p, len);
+        } else {
+            n = urc_recv_process(at, (char *)p, len);
+            if (at->cursor != NULL)             //ʱ(URC)Ӧ
+                resp_recv_process(at, (char *)p, n);
+        }
+        at->stats.rx_bytes += n;
+        at_ring_consume(&at->rx, n);
+        p = at_ring_rspan(&at->rx, &len);
+    } while (len > 0);
+}
+
 /*
  * @brief  ATѯ
  */
 void at_poll_task(at_obj_t *at)
 {
-    char rbuf[32];
-    int read_size;
-    read_size = __get_adapter(at)->read(rbuf, sizeof(rbuf));
-    urc_recv_process(at, rbuf, read_size);
-    resp_recv_process(at, rbuf, read_size);    
+    rx_process(at);
     at_work_manager(at);
 }
 
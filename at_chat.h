@@ -14,10 +14,46 @@
 #define _ATCHAT_H_
 
 #include "at_util.h"
+#include "at_prefix.h"
+#include "at_match.h"
+#include "at_parse.h"
+#include "at_tmpl.h"
+#include "at_stream.h"
+#include "at_latency.h"
+#include "at_stats.h"
+#include "at_ring.h"
 #include <list.h>
 #include <stdbool.h>
 
-#define MAX_AT_CMD_LEN          128
+/*
+ * MAX_AT_CMD_LENֿʽ; (%e %f %g %a)
+ * AT_STREAM_FLOAT_SIZE - 1ֽ, ֽضϲstats.tx_truncated
+ */
+#define MAX_AT_CMD_LEN          128                             /*ͷֿСϲ󳤶*/
+
+#ifndef AT_BATCH_MAX
+#define AT_BATCH_MAX            8                               /*ϲ*/
+#endif
+
+#ifndef AT_ITEM_DEF
+#define AT_ITEM_DEF             10                              /*ڲҵشС*/
+#endif
+
+/*ҵȼ -----------------------------------------------------------------*/
+#define AT_PRIO_LOW             0
+#define AT_PRIO_NORMAL          1
+#define AT_PRIO_HIGH            2
+#define AT_PRIO_URGENT          3
+
+#ifndef AT_PRIO_AGING
+#define AT_PRIO_AGING           1000                            /*ȴһ(ms)*/
+#endif
+
+#define AT_DATA_PROMPT          ">"                             /*ݷʾ*/
+
+#ifndef AT_RX_BUFSIZE
+#define AT_RX_BUFSIZE           64                              /*ĬϽջС*/
+#endif
 
 struct at_obj;
 
@@ -25,11 +61,13 @@ struct at_obj;
 typedef struct {
     const char *prefix;  //Ҫƥͷ
     void (*handler)(char *recvbuf, int size); 
+    char        endmark; //(+IPD':'), 0 - 
 }utc_item_t;
 
 typedef struct {
     unsigned int (*write)(const void *buf, unsigned int len);   /*ͽӿ*/
-    unsigned int (*read)(void *buf, unsigned int len);          /*սӿ*/
+    unsigned int (*writev)(const at_iovec_t *iov, int cnt);     /*ɢд(ѡ)*/
+    unsigned int (*read)(void *buf, unsigned int len);          /*սӿ, ΪNULLʱat_rx_push*/
     /*Events -----------------------------------------------------------------*/
     void         (*before_at)(void);                            /*ʼִAT*/
     void         (*after_at)(void);
@@ -40,6 +78,26 @@ typedef struct {
 	unsigned short urc_tbl_count;
 	unsigned short urc_bufsize;                                 /*urcС*/
     unsigned short rcv_bufsize;                                 /*ջ*/
+    /*URCǰ׺(ѡ, ΪNULLʱ˳ƥ) ---------------------------*/
+    at_prefix_node_t *urc_nodes;                                /*ڵ*/
+    unsigned short   urc_node_count;                            /*ڵ*/
+    /*ջλ(ѡ, ΪNULLʱʹڲAT_RX_BUFSIZEֽڻ) ---------*/
+    unsigned char    *rx_buf;
+    unsigned short   rx_bufsize;
+    unsigned char    batch;                                     /*ϲڵĲѯ(V.250 ';')*/
+    /*ս(ѡ, ΪNULLʱʹat_result_def, AT_MATCH_MAX-1) ---*/
+    const at_result_t *result_tbl;
+    unsigned char    result_count;
+    /*Ӧʱ(ѡ, ΪNULLʱ/ʹù̶ʱԼ) --------*/
+    at_lat_entry_t   *lat_tbl;                                  /*ʱͳƱ*/
+    unsigned char    lat_count;
+    unsigned int     tmo_min, tmo_max;                          /*Ӧʱ(ms)*/
+    unsigned int     *urc_hits;                                 /*URC(ѡ, URCȳ)*/
+    /*ҵ(ѡ, ΪNULLʱʹڲAT_ITEM_DEF) ---------------------------*/
+    struct at_item   *item_tbl;
+    unsigned short   item_count;
+    struct at_item * (*item_alloc)(void);                       /*ҵغľʱ(ѡ, NULLʾ)*/
+    void         (*item_ready)(void);                           /*ύܾ, ҵп*/
 }at_obj_conf_t;
 
 /*ATҵл*/
@@ -54,6 +112,7 @@ typedef struct {
     unsigned int(*recvlen)(struct at_obj *at);                 /*ܳ*/
     void        (*recvclr)(struct at_obj *at);                 /*սջ*/
     bool        (*abort)(struct at_obj *at);                   /*ִֹ*/
+    void        (*tmpl)(struct at_obj *at, const at_tmpl_t *t, const at_arg_t *args); /*ģ巢*/
 }at_env_t;
 
 /*ATӦ*/
@@ -70,6 +129,9 @@ typedef struct {
 	char           *recvbuf;
 	unsigned short  recvcnt;
     at_return       ret;
+    const at_lines_t *lines;                                   /*Ӧнṹ(ƫrecvbuf), ΪNULL*/
+    unsigned char   result;                                    /*ս(at_result_class)*/
+    short           code;                                      /*+CME/+CMS, -1 - */
 }at_response_t;
 
 typedef void (*at_callbatk_t)(at_response_t *r);
@@ -81,29 +143,71 @@ typedef enum {
     AT_STATE_EXEC,                                             /*ִ*/
 }at_work_state;
 
+/*Эҵ(λҵ, ҵҵط) */
+typedef struct at_job {
+    struct at_obj  *at;
+    void           *params;
+    unsigned short  lc;                                         /*ָ, 0 - ʼ*/
+    unsigned short  i;                                          /*ͨü(Դ)*/
+    unsigned int    timer;                                      /*ֹ߽ʱ/ȴʼʱ*/
+    at_return       ret;                                        /*һεȴĽ*/
+    const char     *cmd;                                        /*һη͵(ʱͳ)*/
+}at_job_t;
+
 /*ATҵ*/
-typedef struct {
+typedef struct at_item {
     at_work_state state : 3;
     unsigned char type  : 3;
     unsigned char abort : 1;
+    unsigned char nobatch : 1;                                  /*ϲ*/
+    unsigned char prio  : 2;                                    /*ȼ*/
+    unsigned char sleep : 1;                                    /*Эҵ*/
+    unsigned int  stamp;                                        /*ʱ*/
     void          *param;
 	void          *info;
     struct list_head node;
+    at_job_t      job;                                          /*Эҵ*/
 }at_item_t;
 
 /*AT ------------------------------------------------------------------*/
 typedef struct at_obj{
 	at_obj_conf_t          cfg;
     at_env_t                env;
-	at_item_t               tbl[10];
+	at_item_t               tbl[AT_ITEM_DEF];
     at_item_t               *cursor;
     struct list_head        ls_ready, ls_idle;               /*,ҵ*/
+    at_prefix_t             urc_idx;                         /*URCǰ׺*/
+    at_match_t              matcher;                         /*Ӧƥ*/
+    at_lines_t              lines;                           /*Ӧнṹ*/
+    at_ring_t               rx;                              /*ջ*/
+    unsigned char           rx_def[AT_RX_BUFSIZE];
 	unsigned int            resp_timer;
+    unsigned int            resp_tmo;                        /*ǰӦʱ/Լ*/
+    at_lat_t                lat;                             /*ʱͳ*/
+    at_stats_t              stats;                           /*ͳ(ֱӶȡ)*/
+    unsigned int            tx_us;                           /*ʱ(us)*/
 	unsigned int            urc_timer;
 	at_return               ret;
 	//urcռ, Ӧռ
 	unsigned short          urc_cnt, rcv_cnt;
+    signed char             matched;                         /*ƥ*/
+    signed char             match_ok;                        /*ƥ䴮ƥ, -1 - */
+    unsigned char           result;                          /*ս*/
+    short                   code;                            /*+CME/+CMS*/
+    unsigned char           batch;                           /*ǰϲִе*/
+    char                    urc_endmarks[4];                 /*URCǼ*/
+    unsigned int            raw_left;                        /*ʣ೤*/
+    at_sink_t               raw_sink;
+    void                    *raw_param;
+    unsigned short          item_total, item_used;           /*ҵ, ʹ*/
+    unsigned short          item_peak;                       /*ʹֵ*/
+    unsigned int            item_rejected;                   /*ύܾ*/
 	unsigned char           suspend: 1;
+    unsigned char           urc_indexed : 1;                 /*URCЧ*/
+    unsigned char           item_starved : 1;                /*ύܾ, ȴ*/
+    unsigned char           first_rx : 1;                    /*ȴӦֽ*/
+    unsigned char           idle_wait : 1;                   /*ҵ*/
+    unsigned int            idle_until;                      /*ֹ߽ʱ*/
 }at_obj_t;
 
 typedef struct {
@@ -114,6 +218,24 @@ typedef struct {
     unsigned short timeout;                                 /*ʱʱ */
 }at_cmd_t;
 
+/*ҵͳ */
+typedef struct {
+    unsigned short total;                                   /*ҵ */
+    unsigned short used;                                    /*ǰʹ */
+    unsigned short peak;                                    /*ʹֵ */
+    unsigned int   rejected;                                /*ύܾ */
+}at_pool_stats_t;
+
+/*ݷ */
+typedef struct {
+    const char    *cmd;                                     /*("AT+CIPSEND=0,100") */
+    const void    *buf;                                     /* */
+    unsigned int   len;                                     /*ݳ */
+    const char    *matcher;                                 /*ƥ䴮("SEND OK"), NULL - "OK" */
+    at_callbatk_t  cb;                                      /*Ӧ */
+    unsigned short timeout;                                 /*׶γʱʱ */
+}at_data_t;
+
 void at_obj_init(at_obj_t *at, const at_obj_conf_t cfg);
 
 /*͵AT*/
@@ -122,18 +244,104 @@ bool at_send_singlline(at_obj_t *at, at_callbatk_t cb, const char *singlline);
 bool at_send_multiline(at_obj_t *at, at_callbatk_t cb, const char **multiline);
 /*ִAT*/
 bool at_do_cmd(at_obj_t *at, void *params, const at_cmd_t *cmd);
+/**/
+bool at_send_data(at_obj_t *at, void *params, const at_data_t *data);
+/**/
+void at_recv_data(at_obj_t *at, unsigned int len, at_sink_t sink, void *param);
 /*ԶATҵ*/
 bool at_do_work(at_obj_t *at, int (*work)(at_env_t *e), void *params);
 
+/*ָȼ(AT_PRIO_xxx), ȼҵִ, ȼҵȴû*/
+bool at_send_singlline_prio(at_obj_t *at, at_callbatk_t cb, const char *singlline,
+                            int prio);
+bool at_send_multiline_prio(at_obj_t *at, at_callbatk_t cb, const char **multiline,
+                            int prio);
+bool at_do_cmd_prio(at_obj_t *at, void *params, const at_cmd_t *cmd, int prio);
+bool at_do_work_prio(at_obj_t *at, int (*work)(at_env_t *e), void *params, int prio);
+
+/*Эҵ(д·AT_JOB_xxx)*/
+bool at_do_job(at_obj_t *at, int (*job)(at_job_t *j), void *params);
+bool at_do_job_prio(at_obj_t *at, int (*job)(at_job_t *j), void *params, int prio);
+
+void at_job_send(at_job_t *j, const char *matcher, unsigned int timeout, const char *fmt, ...);
+void at_job_send_tmpl(at_job_t *j, const char *matcher, unsigned int timeout,
+                      const at_tmpl_t *t, const at_arg_t *args);
+bool at_job_resp(at_job_t *j);
+bool at_job_match(at_job_t *j, const char *expect, unsigned int timeout);
+
+bool at_urc_update(at_obj_t *at, utc_item_t *tbl, unsigned short count); /*URC*/
+
 void at_item_abort(at_item_t *it);                          /*ֹǰҵ*/
          
 bool at_obj_busy(at_obj_t *at);                              /*æж*/
 
+void at_pool_stats(at_obj_t *at, at_pool_stats_t *st);      /*ҵͳ*/
+
 void at_suspend(at_obj_t *at);
 
 void at_resume(at_obj_t *at);
 
+unsigned int at_rx_push(at_obj_t *at, const void *buf, unsigned int len); /*д*/
+
 void at_poll_task(at_obj_t *at);
 
+/*Эҵ -------------------------------------------------------------------
+ * ˳ʽдಽ, ÿȴ㷵ѯ, ´δӸõ.
+ * ע: 
+ *   1. ֲڵȴ֮䲻, 豣״̬j->i, j->params̬.
+ *   2. switch/__LINE__ʵ, ͬһֻʹһ, ҵڲʹswitch.
+ * ʾ:
+ *   static int pdp_job(at_job_t *j)
+ *   {
+ *       AT_JOB_BEGIN(j);
+ *       for (j->i = 0; j->i < 3; j->i++) {
+ *           AT_JOB_CMD(j, "OK", 3000, "AT+CGACT=1,1");
+ *           if (j->ret == AT_RET_OK)
+ *               break;
+ *           AT_JOB_SLEEP(j, 2000);                             //ڼִҵ
+ *       }
+ *       AT_JOB_END(j);
+ *   }
+ *   at_do_job(&at, pdp_job, NULL);
+ *---------------------------------------------------------------------------*/
+#define AT_JOB_WAITING          0                               /*ȴ(ռͨ)*/
+#define AT_JOB_YIELDED          1                               /*óͨ*/
+#define AT_JOB_SLEEPING         2                               /*, ǰ*/
+#define AT_JOB_EXITED           3                               /*ҵ*/
+
+#define AT_JOB_BEGIN(j)         switch ((j)->lc) { case 0:
+
+#define AT_JOB_END(j)           } (j)->lc = 0; return AT_JOB_EXITED
+
+#define AT_JOB_EXIT(j)          do { (j)->lc = 0; return AT_JOB_EXITED; } while (0)
+
+/*óͨ, ҵִк*/
+#define AT_JOB_YIELD(j)                                                        \
+    do { (j)->lc = __LINE__; return AT_JOB_YIELDED; case __LINE__:; } while (0)
+
+/*ȴ(ռͨ)*/
+#define AT_JOB_WAIT_UNTIL(j, cond)                                             \
+    do { (j)->lc = __LINE__; case __LINE__: if (!(cond)) return AT_JOB_WAITING; } while (0)
+
+/*ms, ڼóͨ*/
+#define AT_JOB_SLEEP(j, ms)                                                    \
+    do { (j)->timer = at_get_ms() + (ms); (j)->lc = __LINE__;                  \
+         return AT_JOB_SLEEPING; case __LINE__:; } while (0)
+
+/*ȴӦ, j->ret(ƥ䴮ΪNULLʱȴ"OK", ʱΪ0ʱʷʱӦ)*/
+#define AT_JOB_CMD(j, matcher, timeout, ...)                                   \
+    do { at_job_send(j, matcher, timeout, __VA_ARGS__);                        \
+         AT_JOB_WAIT_UNTIL(j, at_job_resp(j)); } while (0)
+
+/*ģ巢ȴӦ, j->ret*/
+#define AT_JOB_CMD_TMPL(j, matcher, timeout, t, args)                          \
+    do { at_job_send_tmpl(j, matcher, timeout, t, args);                       \
+         AT_JOB_WAIT_UNTIL(j, at_job_resp(j)); } while (0)
+
+/*ȴгexpect(">"), j->ret*/
+#define AT_JOB_WAIT_MATCH(j, expect, timeout)                                  \
+    do { (j)->timer = at_get_ms();                                             \
+         AT_JOB_WAIT_UNTIL(j, at_job_match(j, expect, timeout)); } while (0)
+
 
 #endif
@@ -0,0 +1,162 @@
+/******************************************************************************
+ * @brief        Ӧʱͳ(߹Ʒλ), Ӧʱ˱
+ *
+ * Copyright (c) 2020, <morro_luo@163.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Morro        Initial version.
+ ******************************************************************************/
+
+#include "at_latency.h"
+#include <stddef.h>
+
+/*
+ * @brief       ʼʱͳ
+ * @param[in]   tbl     - ͳƱ(ÿռһ, ʱ滻ٵ)
+ * @param[in]   size    - ͳƱ
+ * @param[in]   tmo_min - Ӧʱ(ms)
+ * @param[in]   tmo_max - Ӧʱ(ms)
+ */
+void at_lat_init(at_lat_t *l, at_lat_entry_t *tbl, unsigned char size,
+                 unsigned int tmo_min, unsigned int tmo_max)
+{
+    int i;
+    l->tbl     = size ? tbl : NULL;
+    l->size    = size;
+    l->tmo_min = tmo_min;
+    l->tmo_max = tmo_max;
+    for (i = 0; l->tbl != NULL && i < size; i++)
+        tbl[i].hash = 0;
+}
+
+/*
+ * @brief       ϣ
+ * @details     չʽ: ִ("AT+COPS")ȡ("AT+COPS?")
+ *              ("AT+COPS=?")("AT+COPS=0", ֲ), ɨ
+ *              "AT+COPS=?"ȡ"AT+COPS?"ʱ; ȡĸ
+ *              ("ATD123;"Ϊ"D")
+ */
+static unsigned int cmd_hash(const char *cmd)
+{
+    unsigned int h = 2166136261u;                               /*FNV-1a*/
+    char form = 0;
+    if ((cmd[0] == 'A' || cmd[0] == 'a') && (cmd[1] == 'T' || cmd[1] == 't'))
+        cmd += 2;
+    if ((*cmd >= 'A' && *cmd <= 'Z') || (*cmd >= 'a' && *cmd <= 'z')) {
+        h = (h ^ (*cmd & ~0x20)) * 16777619u;
+    } else {
+        for (; *cmd && *cmd != '=' && *cmd != '?' && *cmd != ';' && *cmd != '\r'; cmd++)
+            h = (h ^ (unsigned char)*cmd) * 16777619u;
+        if (*cmd == '?')
+            form = '?';                                         /*ȡ*/
+        else if (*cmd == '=')
+            form = cmd[1] == '?' ? '!' : '=';                   /*/*/
+        if (form != 0)
+            h = (h ^ (unsigned char)form) * 16777619u;
+    }
+    return h ? h : 1;
+}
+
+/*
+ * @brief       ͳ
+ */
+static at_lat_entry_t *entry_find(const at_lat_t *l, unsigned int h)
+{
+    int i;
+    for (i = 0; i < l->size; i++) {
+        if (l->tbl[i].hash == h)
+            return &l->tbl[i];
+    }
+    return NULL;
+}
+
+/*
+ * @brief       ʱ
+ * @param[in]   cmd - ("AT+CSQ")
+ * @param[in]   ms  - ͵յսʱ, ʱԳʱʱ
+ * @note        P95ƽ: ڹֵʱϵ19, µ1,
+ *              ƽʱǡ5%ֵ; ֵ
+ */
+void at_lat_add(at_lat_t *l, const char *cmd, unsigned int ms)
+{
+    at_lat_entry_t *e, *victim;
+    unsigned int h, step;
+    int i;
+    if (l->tbl == NULL || cmd == NULL)
+        return;
+    h = cmd_hash(cmd);
+    if ((e = entry_find(l, h)) == NULL) {
+        for (victim = &l->tbl[0], i = 1; i < l->size && victim->hash; i++) {
+            if (l->tbl[i].hash == 0 || l->tbl[i].count < victim->count)
+                victim = &l->tbl[i];
+        }
+        e = victim;
+        e->hash  = h;
+        e->p95   = ms;
+        e->max   = ms;
+        e->count = 1;
+        return;
+    }
+    step = e->p95 / 64 + 1;
+    if (ms > e->p95)
+        e->p95 += 19 * step;
+    else
+        e->p95 -= step < e->p95 ? step : e->p95;
+    if (ms > e->max)
+        e->max = ms;
+    if (e->count < 0xFFFF)
+        e->count++;
+}
+
+/*
+ * @brief       ȡP95ʱӹ
+ * @return      0 - 
+ */
+static unsigned int p95_get(const at_lat_t *l, const char *cmd)
+{
+    at_lat_entry_t *e;
+    if (l->tbl == NULL || cmd == NULL || (e = entry_find(l, cmd_hash(cmd))) == NULL ||
+        e->count < AT_LAT_WARMUP)
+        return 0;
+    return e->p95 ? e->p95 : 1;
+}
+
+/*
+ * @brief       ȡʱʱ
+ * @param[in]   def   - ʱĻ׼ʱ
+ * @param[in]   retry - Դ, ÿԳʱӱ
+ * @return      ʱʱ(ms), [tmo_min, tmo_max]֮(tmo_maxΪ0ʱ)
+ */
+unsigned int at_lat_timeout(const at_lat_t *l, const char *cmd, unsigned int def,
+                            int retry)
+{
+    unsigned int t = p95_get(l, cmd);
+    t = t ? t * AT_LAT_FACTOR : def;
+    while (retry-- > 0 && (l->tmo_max == 0 || t < l->tmo_max))
+        t <<= 1;
+    if (t < l->tmo_min)
+        t = l->tmo_min;
+    if (l->tmo_max && t > l->tmo_max)
+        t = l->tmo_max;
+    return t;
+}
+
+/*
+ * @brief       ȡǰ˱ʱ
+ * @param[in]   def   - ʱ˱ʱ, ͬʱΪ˱
+ * @param[in]   retry - Դ, ÿ˱ܼӱ
+ * @return      ˱ʱ(ms)
+ */
+unsigned int at_lat_backoff(const at_lat_t *l, const char *cmd, unsigned int def,
+                            int retry)
+{
+    unsigned int t = p95_get(l, cmd);
+    if (t == 0)
+        return def;
+    while (retry-- > 0 && t < def)
+        t <<= 1;
+    return t < def ? t : def;
+}
@@ -0,0 +1,51 @@
+/******************************************************************************
+ * @brief        Ӧʱͳ(߹Ʒλ), Ӧʱ˱
+ *
+ * Copyright (c) 2020, <morro_luo@163.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Morro        Initial version.
+ ******************************************************************************/
+
+#ifndef _AT_LATENCY_H_
+#define _AT_LATENCY_H_
+
+#ifndef AT_LAT_WARMUP
+#define AT_LAT_WARMUP           4                               /*ﵽŲùֵ*/
+#endif
+
+#ifndef AT_LAT_FACTOR
+#define AT_LAT_FACTOR           3                               /*ʱ = P95ʱ * */
+#endif
+
+/*ʱͳ(ÿʽһ) -------------------------------------------*/
+typedef struct {
+    unsigned int   hash;                                        /*ϣ, 0 - */
+    unsigned int   p95;                                         /*P95ʱӹ(ms)*/
+    unsigned short count;                                       /**/
+    unsigned int   max;                                         /*ʱ(ms)*/
+}at_lat_entry_t;
+
+/*ʱͳ -------------------------------------------------------------------*/
+typedef struct {
+    at_lat_entry_t *tbl;                                        /*ͳƱ, ΪNULLʱ*/
+    unsigned char   size;                                       /*ͳƱ*/
+    unsigned int    tmo_min;                                    /*ʱ(ms)*/
+    unsigned int    tmo_max;                                    /*ʱ(ms)*/
+}at_lat_t;
+
+void at_lat_init(at_lat_t *l, at_lat_entry_t *tbl, unsigned char size,
+                 unsigned int tmo_min, unsigned int tmo_max);
+
+void at_lat_add(at_lat_t *l, const char *cmd, unsigned int ms);
+
+unsigned int at_lat_timeout(const at_lat_t *l, const char *cmd, unsigned int def,
+                            int retry);
+
+unsigned int at_lat_backoff(const at_lat_t *l, const char *cmd, unsigned int def,
+                            int retry);
+
+#endif
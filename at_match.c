@@ -0,0 +1,135 @@
+/******************************************************************************
+ * @brief        ʽģʽƥ(ݿ鱣״̬, ÿֻֽɨһ)
+ *
+ * Copyright (c) 2020, <morro_luo@163.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Morro        Initial version.
+ ******************************************************************************/
+
+#include "at_match.h"
+#include <string.h>
+
+/*
+ * @brief       ģʽ
+ */
+void at_match_reset(at_match_t *m)
+{
+    m->count = 0;
+    m->last  = '\n';
+}
+
+/*
+ * @brief       ƥģʽ
+ * @param[in]   pattern - ģʽ(ƥڼ뱣Ч)
+ * @return      ģʽ(ͬʱʱС), -1 - ģʽΪմ
+ */
+int at_match_add(at_match_t *m, const char *pattern)
+{
+    return at_match_add_flags(m, pattern, 0);
+}
+
+/*
+ * @brief       Ӵ־ƥģʽ
+ * @param[in]   flags - AT_MATCH_BOL: ģʽֻ׿ʼƥ("ERROR"ƥ
+ *                      "+CME ERROR:"еӴ);
+ *                      AT_MATCH_EOL: ģʽƥȵ'\r''\n'
+ *                      ("+CME ERROR: <n>"ȴĽ)
+ */
+int at_match_add_flags(at_match_t *m, const char *pattern, unsigned char flags)
+{
+    at_pattern_t *p;
+    if (m->count >= AT_MATCH_MAX || pattern == NULL || *pattern == '\0')
+        return -1;
+    p = &m->pat[m->count];
+    p->str   = pattern;
+    p->len   = strlen(pattern);
+    p->state = 0;
+    p->flags = flags;
+    p->pending = 0;
+    return m->count++;
+}
+
+/*
+ * @brief       λƥ״̬(ģʽ), սջ֮
+ */
+void at_match_restart(at_match_t *m)
+{
+    int i;
+    for (i = 0; i < m->count; i++) {
+        m->pat[i].state   = 0;
+        m->pat[i].pending = 0;
+    }
+    m->last = '\n';
+}
+
+/*
+ * @brief       ʧ
+ * @details     ƥs[0..q-1], ǰַcƥ, s[0..q-1]+c׺
+ *              ʹͬʱΪsǰ׺(KMPʧ亯, ģʽ϶, )
+ */
+static unsigned short fallback(const char *s, unsigned short q, char c)
+{
+    unsigned short k;
+    for (k = q; k > 0; k--) {
+        if (s[k - 1] == c && memcmp(s, s + q - k + 1, k - 1) == 0)
+            return k;
+    }
+    return 0;
+}
+
+/*
+ * @brief       
+ * @param[in]   buf  - ݿ
+ * @param[in]   len  - ݳ
+ * @param[out]  used - Ѵ(ƥɹʱΪģʽһֽ֮λ), ΪNULL
+ * @return      ƥģʽ, -1 - δƥ
+ */
+int at_match_feed(at_match_t *m, const char *buf, unsigned int len,
+                  unsigned int *used)
+{
+    at_pattern_t *p, *end = &m->pat[m->count];
+    unsigned int n;
+    int hit = -1;
+    bool bol, eol;
+    char c;
+    for (n = 0; n < len && hit < 0; ) {
+        bol = m->last == '\r' || m->last == '\n';
+        c = m->last = buf[n++];
+        eol = c == '\r' || c == '\n';
+        for (p = m->pat; p < end; p++) {
+            if (p->pending) {                               /*ȴβ*/
+                if (!eol)
+                    continue;
+                p->pending = 0;
+            } else {
+                if (p->str[p->state] == c) {
+                    if (p->state == 0 && (p->flags & AT_MATCH_BOL) && !bol)
+                        continue;
+                    p->state++;
+                } else if (p->state) {
+                    p->state = (p->flags & AT_MATCH_BOL) ? 0 : 
+                               fallback(p->str, p->state, c);
+                    continue;
+                } else {
+                    continue;
+                }
+                if (p->state < p->len)
+                    continue;
+                p->state = 0;
+                if (p->flags & AT_MATCH_EOL) {
+                    p->pending = 1;
+                    continue;
+                }
+            }
+            if (hit < 0)
+                hit = p - m->pat;
+        }
+    }
+    if (used)
+        *used = n;
+    return hit;
+}
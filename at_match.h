@@ -0,0 +1,53 @@
+/******************************************************************************
+ * @brief        ʽģʽƥ(ݿ鱣״̬, ÿֻֽɨһ)
+ *
+ * Copyright (c) 2020, <morro_luo@163.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Morro        Initial version.
+ ******************************************************************************/
+
+#ifndef _AT_MATCH_H_
+#define _AT_MATCH_H_
+
+#include <stdbool.h>
+
+#ifndef AT_MATCH_MAX
+#define AT_MATCH_MAX            10                              /*ģʽ*/
+#endif
+
+/*ģʽ־ -------------------------------------------------------------------*/
+#define AT_MATCH_BOL            0x01                            /*ֻ׿ʼƥ*/
+#define AT_MATCH_EOL            0x02                            /*ƥȵβ*/
+
+/*ƥģʽ -------------------------------------------------------------------*/
+typedef struct {
+    const char     *str;                                        /*ģʽ*/
+    unsigned short  len;                                        /*ģʽ*/
+    unsigned short  state;                                      /*ƥ䳤*/
+    unsigned char   flags;                                      /*AT_MATCH_xxx*/
+    unsigned char   pending;                                    /*ƥ, ȴβ*/
+}at_pattern_t;
+
+/*ƥ ---------------------------------------------------------------------*/
+typedef struct {
+    at_pattern_t    pat[AT_MATCH_MAX];
+    unsigned char   count;
+    char            last;                                       /*һֽ*/
+}at_match_t;
+
+void at_match_reset(at_match_t *m);
+
+int  at_match_add(at_match_t *m, const char *pattern);
+
+int  at_match_add_flags(at_match_t *m, const char *pattern, unsigned char flags);
+
+void at_match_restart(at_match_t *m);
+
+int  at_match_feed(at_match_t *m, const char *buf, unsigned int len,
+                   unsigned int *used);
+
+#endif
@@ -0,0 +1,400 @@
+/******************************************************************************
+ * @brief        ATӦ(ֶͼ, ޸/ƽջ)
+ *
+ * Copyright (c) 2020, <morro_luo@163.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Morro        Initial version.
+ ******************************************************************************/
+
+#include "at_parse.h"
+#include <limits.h>
+#include <stdarg.h>
+#include <string.h>
+
+/*Ĭս -----------------------------------------------------------*/
+const at_result_t at_result_def[AT_RESULT_DEF_COUNT] = {
+    {"ERROR",       AT_RESULT_ERROR},
+    {"+CME ERROR:", AT_RESULT_CME_ERROR},
+    {"+CMS ERROR:", AT_RESULT_CMS_ERROR},
+    {"NO CARRIER",  AT_RESULT_NO_CARRIER},
+    {"BUSY",        AT_RESULT_BUSY},
+    {"NO ANSWER",   AT_RESULT_NO_ANSWER},
+    {"NO DIALTONE", AT_RESULT_NO_DIALTONE},
+};
+
+/*
+ * @brief       ʼִ
+ * @param[in]   buf - Ӧ(ɺ)
+ * @param[in]   len - ݳ
+ */
+void at_tok_init(at_tok_t *t, const char *buf, unsigned int len)
+{
+    t->p   = buf;
+    t->end = buf + len;
+    t->sep = 0;
+}
+
+/*
+ * @brief       ȡһǿ
+ * @param[out]  line - зִ("\r\n")
+ * @return      false - ûи
+ */
+bool at_tok_line(at_tok_t *t, at_tok_t *line)
+{
+    const char *s;
+    while (t->p < t->end && (*t->p == '\r' || *t->p == '\n' || *t->p == '\0'))
+        t->p++;
+    if (t->p >= t->end)
+        return false;
+    for (s = t->p; t->p < t->end && *t->p != '\r' && *t->p != '\n' && *t->p != '\0';)
+        t->p++;
+    at_tok_init(line, s, t->p - s);
+    return true;
+}
+
+/*
+ * @brief       ǰ׺("+CSQ:"), Ŀո
+ * @return      false - вprefixͷ(λò)
+ */
+bool at_tok_prefix(at_tok_t *t, const char *prefix)
+{
+    unsigned int n = strlen(prefix);
+    if ((unsigned int)(t->end - t->p) < n || memcmp(t->p, prefix, n) != 0)
+        return false;
+    t->p += n;
+    while (t->p < t->end && *t->p == ' ')
+        t->p++;
+    return true;
+}
+
+/*
+ * @brief       ȡһֶ
+ * @details     ֶ','ָ, ȥβո; ڵ','ָ, صͼ;
+ *              б("(0-1),(2,3)")Ϊһֶη, 
+ * @param[out]  f - ֶͼ
+ * @return      false - ûиֶ
+ */
+bool at_tok_field(at_tok_t *t, at_field_t *f)
+{
+    const char *p = t->p, *end = t->end, *s, *e;
+    int depth = 0;
+    if (p >= end && !t->sep)
+        return false;
+    while (p < end && *p == ' ')
+        p++;
+    if (p < end && *p == '"') {                                 /*ֶ*/
+        s = ++p;
+        while (p < end && *p != '"')
+            p++;
+        e = p;
+        while (p < end && *p != ',')
+            p++;
+    } else {
+        s = p;
+        for (; p < end; p++) {
+            if (*p == '(')
+                depth++;
+            else if (*p == ')' && depth > 0)
+                depth--;
+            else if (*p == ',' && depth == 0)
+                break;
+        }
+        e = p;
+        while (e > s && e[-1] == ' ')
+            e--;
+    }
+    f->s   = s;
+    f->len = e - s;
+    t->sep = p < end;                                           /*ͣ','*/
+    t->p   = t->sep ? p + 1 : p;
+    return true;
+}
+
+/*
+ * @brief       ȡǰʣֶ
+ * @param[out]  f   - ֶͼ
+ * @param[in]   max - 
+ * @return      ֶ
+ */
+int at_tok_fields(at_tok_t *t, at_field_t *f, int max)
+{
+    int n = 0;
+    while (n < max && at_tok_field(t, &f[n]))
+        n++;
+    return n;
+}
+
+/*
+ * @brief       ֶתΪʮ
+ * @return      false - ֶΡַ򳬳intΧ
+ */
+bool at_field_int(const at_field_t *f, int *value)
+{
+    const char *p = f->s, *end = f->s + f->len;
+    bool neg = false;
+    unsigned int v = 0, d, limit;
+    if (p < end && (*p == '-' || *p == '+'))
+        neg = *p++ == '-';
+    if (p >= end)
+        return false;
+    limit = neg ? (unsigned int)INT_MAX + 1 : INT_MAX;
+    for (; p < end; p++) {
+        if (*p < '0' || *p > '9')
+            return false;
+        d = *p - '0';
+        if (v > (limit - d) / 10)                               /**/
+            return false;
+        v = v * 10 + d;
+    }
+    *value = neg && v > 0 ? -(int)(v - 1) - 1 : (int)v;
+    return true;
+}
+
+/*
+ * @brief       ֶתΪʮ(ɴ"0x"ǰ׺)
+ * @return      false - ֶΡʮַ򳬳unsigned intΧ
+ */
+bool at_field_hex(const at_field_t *f, unsigned int *value)
+{
+    const char *p = f->s, *end = f->s + f->len;
+    unsigned int v = 0;
+    char c;
+    if (end - p > 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
+        p += 2;
+    if (p >= end)
+        return false;
+    for (; p < end; p++) {
+        c = *p;
+        if (c >= '0' && c <= '9')
+            c -= '0';
+        else if (c >= 'a' && c <= 'f')
+            c -= 'a' - 10;
+        else if (c >= 'A' && c <= 'F')
+            c -= 'A' - 10;
+        else
+            return false;
+        if (v > UINT_MAX >> 4)                                  /**/
+            return false;
+        v = (v << 4) | c;
+    }
+    *value = v;
+    return true;
+}
+
+/*
+ * @brief       ֶΪַ
+ * @param[out]  buf  - ('\0'β, ض)
+ * @param[in]   size - С
+ * @return      Ƶĳ
+ */
+int at_field_str(const at_field_t *f, char *buf, unsigned int size)
+{
+    unsigned int n = f->len;
+    if (size == 0)
+        return 0;
+    if (n > size - 1)
+        n = size - 1;
+    memcpy(buf, f->s, n);
+    buf[n] = '\0';
+    return n;
+}
+
+/*
+ * @brief       λӦнṹ(սջʱ)
+ */
+void at_lines_reset(at_lines_t *l)
+{
+    l->count    = 0;
+    l->done     = 0;
+    l->overflow = 0;
+    l->start    = 0;
+    l->scan     = 0;
+}
+
+/*
+ * @brief       ¼һ
+ * @details     һ"AT"ͷʱΪ; AT_LINE_MAXʱһ,
+ *              ֤սܱ¼
+ */
+static void line_add(at_lines_t *l, const char *buf, unsigned int end)
+{
+    const char *s = buf + l->start;
+    unsigned char k = l->count;
+    if (end <= l->start)                                        /**/
+        return;
+    if (k >= AT_LINE_MAX) {
+        k = AT_LINE_MAX - 1;
+        l->overflow = 1;
+    } else {
+        l->count++;
+    }
+    l->off[k]  = l->start;
+    l->len[k]  = end - l->start;
+    l->type[k] = (k == 0 && end - l->start >= 2 && (s[0] == 'A' || s[0] == 'a') &&
+                  (s[1] == 'T' || s[1] == 't')) ? AT_LINE_ECHO : AT_LINE_INFO;
+}
+
+/*
+ * @brief       ½յ
+ * @param[in]   buf - ջʼַ
+ * @param[in]   cnt - ǰݳ(ֻɨϴ֮Ĳ)
+ */
+void at_lines_feed(at_lines_t *l, const char *buf, unsigned int cnt)
+{
+    unsigned int i;
+    if (l->done)
+        return;
+    for (i = l->scan; i < cnt; i++) {
+        if (buf[i] == '\r' || buf[i] == '\n') {
+            line_add(l, buf, i);
+            l->start = i + 1;
+        }
+    }
+    l->scan = i;
+}
+
+/*
+ * @brief       ¼
+ * @param[in]   final - true: һΪս(Ӧƥ), false: ʱֹ
+ * @note        δԻнһ(ʾ">")Ҳᱻ¼
+ */
+void at_lines_finish(at_lines_t *l, const char *buf, unsigned int cnt, bool final)
+{
+    if (l->done)
+        return;
+    at_lines_feed(l, buf, cnt);
+    line_add(l, buf, cnt);
+    l->start = cnt;
+    if (final && l->count)
+        l->type[l->count - 1] = AT_LINE_FINAL;
+    l->done = 1;
+}
+
+/*
+ * @brief       prefixͷĵһϢ
+ * @return      к, -1 - δҵ
+ */
+int at_lines_find(const at_lines_t *l, const char *buf, const char *prefix)
+{
+    unsigned int n = strlen(prefix);
+    int i;
+    for (i = 0; i < l->count; i++) {
+        if (l->type[i] == AT_LINE_INFO && l->len[i] >= n &&
+            memcmp(buf + l->off[i], prefix, n) == 0)
+            return i;
+    }
+    return -1;
+}
+
+/*
+ * @brief       еֵ("+CME ERROR: 10")
+ * @param[in]   buf - ջ
+ * @param[in]   end - нλ(ɺβ"\r\n")
+ * @return      , -1 - ֵ(AT+CMEE=2ʱıʽ)
+ */
+int at_result_code(const char *buf, unsigned int end)
+{
+    at_field_t f;
+    unsigned int i;
+    int code;
+    while (end > 0 && (buf[end - 1] == '\r' || buf[end - 1] == '\n'))
+        end--;
+    for (i = end; i > 0 && buf[i - 1] != ':'; i--) {
+        if (buf[i - 1] == '\r' || buf[i - 1] == '\n')
+            return -1;
+    }
+    if (i == 0)
+        return -1;
+    while (i < end && buf[i] == ' ')
+        i++;
+    f.s   = buf + i;
+    f.len = end - i;
+    return at_field_int(&f, &code) ? code : -1;
+}
+
+/*
+ * @brief       ֶģ
+ * @param[in]   fmt - ģ, һ'%'֮ǰΪǰ׺, ֮Ϊ','ֶָ:
+ *                    %d - int*, %x - unsigned int*, %s - at_field_t*, %* - 
+ *                    ("+CSQ: %d,%d", "+COPS: %d,%d,%s")
+ * @return      false - ģʽֶι
+ * @note        fmtģʹڼ뱣Ч
+ */
+bool at_spec_compile(at_spec_t *sp, const char *fmt)
+{
+    const char *p = strchr(fmt, '%');
+    if (p == NULL)
+        return false;
+    sp->prefix = fmt;
+    sp->plen   = p - fmt;
+    while (sp->plen > 0 && fmt[sp->plen - 1] == ' ')             /*ոɷִ*/
+        sp->plen--;
+    sp->count  = 0;
+    while (*p) {
+        if (*p == ',' || *p == ' ') {
+            p++;
+            continue;
+        }
+        if (*p != '%' || sp->count >= AT_SPEC_MAX)
+            return false;
+        switch (p[1]) {
+        case 'd': case 'x': case 's': case '*':
+            sp->type[sp->count++] = p[1];
+            break;
+        default:
+            return false;
+        }
+        p += 2;
+    }
+    return true;
+}
+
+/*
+ * @brief       ģӦ
+ * @param[in]   buf - Ӧ(ɺ, ȡһģǰ׺ͷ)
+ * @param[in]   len - ݳ
+ * @param[out]  ... - ֶָ, ģֶͶӦ(%*ռ)
+ * @return      ɹתֶ(%*, ȱʧʽֶμֹͣ),
+ *              -1 - δҵǰ׺
+ */
+int at_spec_parse(const at_spec_t *sp, const char *buf, unsigned int len, ...)
+{
+    at_tok_t t, line;
+    at_field_t f;
+    va_list ap;
+    int k, n = 0;
+    at_tok_init(&t, buf, len);
+    for (;;) {
+        if (!at_tok_line(&t, &line))
+            return -1;
+        if (line.end - line.p >= sp->plen && memcmp(line.p, sp->prefix, sp->plen) == 0)
+            break;
+    }
+    line.p += sp->plen;
+    va_start(ap, len);
+    for (k = 0; k < sp->count && at_tok_field(&line, &f); k++) {
+        switch (sp->type[k]) {
+        case 'd':
+            if (!at_field_int(&f, va_arg(ap, int *)))
+                goto done;
+            break;
+        case 'x':
+            if (!at_field_hex(&f, va_arg(ap, unsigned int *)))
+                goto done;
+            break;
+        case 's':
+            *va_arg(ap, at_field_t *) = f;
+            break;
+        default:                                                /*%* , */
+            continue;
+        }
+        n++;
+    }
+done:
+    va_end(ap);
+    return n;
+}
@@ -0,0 +1,117 @@
+/******************************************************************************
+ * @brief        ATӦ(ֶͼ, ޸/ƽջ)
+ *
+ * Copyright (c) 2020, <morro_luo@163.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Morro        Initial version.
+ ******************************************************************************/
+
+#ifndef _AT_PARSE_H_
+#define _AT_PARSE_H_
+
+#include <stdbool.h>
+
+#ifndef AT_SPEC_MAX
+#define AT_SPEC_MAX             8                               /*ֶģֶ*/
+#endif
+
+#ifndef AT_LINE_MAX
+#define AT_LINE_MAX             8                               /*¼Ӧ*/
+#endif
+
+/*Ӧ -----------------------------------------------------------------*/
+#define AT_LINE_ECHO            0                               /**/
+#define AT_LINE_INFO            1                               /*Ϣ*/
+#define AT_LINE_FINAL           2                               /*ս(OK/ERROR...)*/
+
+/*Ӧнṹ(ʱֽڼ¼, ڽջ) ----------------------*/
+typedef struct {
+    unsigned short  off[AT_LINE_MAX];                           /*ʼƫ*/
+    unsigned short  len[AT_LINE_MAX];                           /*г("\r\n")*/
+    unsigned char   type[AT_LINE_MAX];                          /**/
+    unsigned char   count;                                      /**/
+    unsigned char   done     : 1;                               /*ѽ*/
+    unsigned char   overflow : 1;                               /*, мб*/
+    unsigned short  start;                                      /*ǰʼ(ڲʹ)*/
+    unsigned short  scan;                                       /*ɨλ(ڲʹ)*/
+}at_lines_t;
+
+/*ս ---------------------------------------------------------------*/
+typedef enum {
+    AT_RESULT_NONE = 0,                                         /*(ƥɹ/ʱ/ֹ)*/
+    AT_RESULT_ERROR,                                            /*ERROR*/
+    AT_RESULT_CME_ERROR,                                        /*+CME ERROR: <n>*/
+    AT_RESULT_CMS_ERROR,                                        /*+CMS ERROR: <n>*/
+    AT_RESULT_NO_CARRIER,
+    AT_RESULT_BUSY,
+    AT_RESULT_NO_ANSWER,
+    AT_RESULT_NO_DIALTONE,
+    AT_RESULT_USER,                                             /*ûԶʼֵ*/
+}at_result_class;
+
+/*ս(ʧ, ɹƥ䴮) ---------------------------*/
+typedef struct {
+    const char     *code;                                       /*, ':'βʾֵ*/
+    unsigned char   cls;                                        /*at_result_class*/
+}at_result_t;
+
+extern const at_result_t at_result_def[];                       /*ĬϽ*/
+
+#define AT_RESULT_DEF_COUNT     7
+
+/*ֶͼ(ָԭ, '\0'β) --------------------------------------*/
+typedef struct {
+    const char     *s;
+    unsigned short  len;
+}at_field_t;
+
+/*ִ ---------------------------------------------------------------------*/
+typedef struct {
+    const char     *p;                                          /*ǰλ*/
+    const char     *end;                                        /*λ*/
+    unsigned char   sep;                                        /*һֶ','*/
+}at_tok_t;
+
+/*ֶģ("+CSQ: %d,%d"), һκظʹ ------------------------------*/
+typedef struct {
+    const char     *prefix;                                     /*ǰ׺*/
+    unsigned char   plen;                                       /*ǰ׺*/
+    unsigned char   count;                                      /*ֶ*/
+    char            type[AT_SPEC_MAX];                          /*'d','x','s','*'*/
+}at_spec_t;
+
+void at_tok_init(at_tok_t *t, const char *buf, unsigned int len);
+
+bool at_tok_line(at_tok_t *t, at_tok_t *line);                 /*ȡһǿ*/
+
+bool at_tok_prefix(at_tok_t *t, const char *prefix);           /*ǰ׺*/
+
+bool at_tok_field(at_tok_t *t, at_field_t *f);                 /*ȡһֶ*/
+
+int  at_tok_fields(at_tok_t *t, at_field_t *f, int max);
+
+bool at_field_int(const at_field_t *f, int *value);
+
+bool at_field_hex(const at_field_t *f, unsigned int *value);
+
+int  at_field_str(const at_field_t *f, char *buf, unsigned int size);
+
+void at_lines_reset(at_lines_t *l);
+
+void at_lines_feed(at_lines_t *l, const char *buf, unsigned int cnt);
+
+void at_lines_finish(at_lines_t *l, const char *buf, unsigned int cnt, bool final);
+
+int  at_lines_find(const at_lines_t *l, const char *buf, const char *prefix);
+
+int  at_result_code(const char *buf, unsigned int end);
+
+bool at_spec_compile(at_spec_t *sp, const char *fmt);
+
+int  at_spec_parse(const at_spec_t *sp, const char *buf, unsigned int len, ...);
+
+#endif
@@ -0,0 +1,111 @@
+/******************************************************************************
+ * @brief        ǰ׺(ֵ), URCȶǰ׺ƥ
+ *
+ * Copyright (c) 2020, <morro_luo@163.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Morro        Initial version.
+ ******************************************************************************/
+
+#include "at_prefix.h"
+#include <stddef.h>
+
+/*
+ * @brief       ʼǰ׺
+ * @param[in]   nodes - ڵ(ڵСǰ׺֮+1)
+ * @param[in]   max   - ڵ
+ */
+void at_prefix_init(at_prefix_t *idx, at_prefix_node_t *nodes, unsigned short max)
+{
+    idx->nodes = nodes;
+    idx->max   = max;
+    idx->count = 0;
+    if (nodes == NULL || max == 0)
+        return;
+    nodes[0].ch      = '\0';                                    /*ڵ*/
+    nodes[0].child   = 0;
+    nodes[0].sibling = 0;
+    nodes[0].id      = AT_PREFIX_NONE;
+    idx->count = 1;
+}
+
+/*
+ * @brief       /ӽڵ(ֵַ)
+ * @return      ڵ, 0 - ڵ
+ */
+static unsigned short child_node(at_prefix_t *idx, unsigned short parent, char c)
+{
+    at_prefix_node_t *n = idx->nodes;
+    unsigned short prev = 0, cur = n[parent].child, k;
+    while (cur && (unsigned char)n[cur].ch < (unsigned char)c) {
+        prev = cur;
+        cur  = n[cur].sibling;
+    }
+    if (cur && n[cur].ch == c)
+        return cur;
+    if (idx->count >= idx->max)
+        return 0;
+    k = idx->count++;
+    n[k].ch      = c;
+    n[k].child   = 0;
+    n[k].sibling = cur;
+    n[k].id      = AT_PREFIX_NONE;
+    if (prev)
+        n[prev].sibling = k;
+    else
+        n[parent].child = k;
+    return k;
+}
+
+/*
+ * @brief       ǰ׺
+ * @param[in]   prefix - ǰ׺(մ)
+ * @param[in]   id     - ǰ׺, ظǰ׺Сı
+ * @return      false - ڵز
+ */
+bool at_prefix_add(at_prefix_t *idx, const char *prefix, unsigned short id)
+{
+    unsigned short k = 0;
+    if (idx->count == 0)
+        return false;
+    if (prefix == NULL || *prefix == '\0')
+        return true;
+    while (*prefix) {
+        if ((k = child_node(idx, k, *prefix++)) == 0)
+            return false;
+    }
+    if (id < idx->nodes[k].id)
+        idx->nodes[k].id = id;
+    return true;
+}
+
+/*
+ * @brief       ǰ׺ƥ
+ * @param[in]   s   - ƥ䴮
+ * @param[in]   len - 
+ * @return      ƥ䵽Сǰ׺(밴˳Բҽһ), -1 - ƥ
+ * @note        Ƚϴֻsƥǰ׺, ǰ׺޹
+ */
+int at_prefix_match(const at_prefix_t *idx, const char *s, unsigned int len)
+{
+    const at_prefix_node_t *n = idx->nodes;
+    unsigned short cur, best = AT_PREFIX_NONE;
+    unsigned char  c;
+    if (idx->count == 0)
+        return -1;
+    cur = n[0].child;
+    while (len-- && cur) {
+        c = (unsigned char)*s++;
+        while (cur && (unsigned char)n[cur].ch < c)
+            cur = n[cur].sibling;
+        if (cur == 0 || (unsigned char)n[cur].ch != c)
+            break;
+        if (n[cur].id < best)
+            best = n[cur].id;
+        cur = n[cur].child;
+    }
+    return best == AT_PREFIX_NONE ? -1 : best;
+}
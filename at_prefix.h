@@ -0,0 +1,42 @@
+/******************************************************************************
+ * @brief        ǰ׺(ֵ), URCȶǰ׺ƥ
+ *
+ * Copyright (c) 2020, <morro_luo@163.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Morro        Initial version.
+ ******************************************************************************/
+
+#ifndef _AT_PREFIX_H_
+#define _AT_PREFIX_H_
+
+#include <stdbool.h>
+
+#define AT_PREFIX_NONE          0xFFFF                          /*Ч*/
+
+/*ֵڵ(ӽڵ/ֵܽڵ, 0ʾ) ---------------------------------*/
+typedef struct {
+    char           ch;                                          /*ڵַ*/
+    unsigned char  reserved;
+    unsigned short child;                                       /*׸ӽڵ*/
+    unsigned short sibling;                                     /*һֵܽڵ*/
+    unsigned short id;                                          /*ǰ׺*/
+}at_prefix_node_t;
+
+/*ǰ׺ -------------------------------------------------------------------*/
+typedef struct {
+    at_prefix_node_t *nodes;                                    /*ڵ*/
+    unsigned short    max;                                      /*ڵ*/
+    unsigned short    count;                                    /*ýڵ*/
+}at_prefix_t;
+
+void at_prefix_init(at_prefix_t *idx, at_prefix_node_t *nodes, unsigned short max);
+
+bool at_prefix_add(at_prefix_t *idx, const char *prefix, unsigned short id);
+
+int  at_prefix_match(const at_prefix_t *idx, const char *s, unsigned int len);
+
+#endif
@@ -0,0 +1,126 @@
+/******************************************************************************
+ * @brief        ջλ(/, )
+ *
+ * (ӿڻж/DMAɻصеat_rx_push)ֻ޸head, ֻ޸tail,
+ * дλõķǰڴ, ߿ڲͬ/ж.
+ *
+ * Copyright (c) 2020, <morro_luo@163.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Morro        Initial version.
+ ******************************************************************************/
+
+#ifndef _AT_RING_H_
+#define _AT_RING_H_
+
+#include <string.h>
+
+/*ڴ(MCUɶΪԼٿ) -----------------------------*/
+#ifndef AT_RING_BARRIER
+#if defined(__GNUC__) || defined(__clang__)
+#define AT_RING_BARRIER()       __sync_synchronize()
+#else
+#define AT_RING_BARRIER()
+#endif
+#endif
+
+/*λ(һֽֿ/) -----------------------------------------*/
+typedef struct {
+    unsigned char        *buf;
+    unsigned int          size;
+    volatile unsigned int head;                                 /*дλ*/
+    volatile unsigned int tail;                                 /*λ*/
+}at_ring_t;
+
+/*
+ * @brief	   ʼλ
+ */
+static inline void at_ring_init(at_ring_t *r, void *buf, unsigned int size)
+{
+    r->buf  = (unsigned char *)buf;
+    r->size = size;
+    r->head = r->tail = 0;
+}
+
+/*
+ * @brief	   ȡݳ
+ */
+static inline unsigned int at_ring_len(const at_ring_t *r)
+{
+    unsigned int h = r->head, t = r->tail;
+    return h >= t ? h - t : r->size - t + h;
+}
+
+/*
+ * @brief	   ȡдռ()
+ * @param[out] len - д
+ */
+static inline unsigned char *at_ring_wspan(at_ring_t *r, unsigned int *len)
+{
+    unsigned int h = r->head, t = r->tail;
+    AT_RING_BARRIER();                                          /*߶ſɸ*/
+    if (h >= t)
+        *len = r->size - h - (t == 0);
+    else
+        *len = t - h - 1;
+    return r->buf + h;
+}
+
+/*
+ * @brief	   ύд()
+ */
+static inline void at_ring_commit(at_ring_t *r, unsigned int n)
+{
+    unsigned int h = r->head + n;
+    AT_RING_BARRIER();                                          /*дٷ*/
+    r->head = h >= r->size ? h - r->size : h;
+}
+
+/*
+ * @brief	   д(, же)
+ * @return     ʵд볤, ռ䲻ʱʣಿ
+ */
+static inline unsigned int at_ring_put(at_ring_t *r, const void *buf, unsigned int len)
+{
+    const unsigned char *s = (const unsigned char *)buf;
+    unsigned char *p;
+    unsigned int n, total = 0;
+    while (total < len) {                                       /*()*/
+        p = at_ring_wspan(r, &n);
+        if (n == 0)
+            break;
+        if (n > len - total)
+            n = len - total;
+        memcpy(p, s + total, n);
+        at_ring_commit(r, n);
+        total += n;
+    }
+    return total;
+}
+
+/*
+ * @brief	   ȡɶ()
+ * @param[out] len - ɶ
+ */
+static inline unsigned char *at_ring_rspan(at_ring_t *r, unsigned int *len)
+{
+    unsigned int h = r->head, t = r->tail;
+    AT_RING_BARRIER();                                          /*ȡheadٶ*/
+    *len = h >= t ? h - t : r->size - t;
+    return r->buf + t;
+}
+
+/*
+ * @brief	   ͷѴ()
+ */
+static inline void at_ring_consume(at_ring_t *r, unsigned int n)
+{
+    unsigned int t = r->tail + n;
+    AT_RING_BARRIER();                                          /*ݶͷ*/
+    r->tail = t >= r->size ? t - r->size : t;
+}
+
+#endif
@@ -0,0 +1,65 @@
+/******************************************************************************
+ * @brief        ATͳ(ʱֱͼ)
+ *
+ * Copyright (c) 2020, <morro_luo@163.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Morro        Initial version.
+ ******************************************************************************/
+
+#ifndef _AT_STATS_H_
+#define _AT_STATS_H_
+
+#include <string.h>
+
+#ifndef AT_STATS_BUCKETS
+#define AT_STATS_BUCKETS        24                              /*ֱͼͰ*/
+#endif
+
+/*
+ * ͳ, ÿֻһִи(߳/),
+ * ֱ߳̿Ӷȡ, (ȡΪԭӲ, ֮䲻֤һ)
+ * ֱͼ: kͰͳʱ(us)λΪk, [2^(k-1), 2^k), һͰֵ
+ */
+typedef struct {
+    volatile unsigned int rx_bytes;                             /*ֽ*/
+    volatile unsigned int tx_bytes;                             /*ֽ*/
+    volatile unsigned int cmd[4];                               /*(at_return)*/
+    volatile unsigned int retries;                              /*Դ*/
+    volatile unsigned int urc_lines;                            /*ѴURC*/
+    volatile unsigned int urc_dropped;                          /*URC(/ճʱ)*/
+    volatile unsigned int urc_overflow;                         /*URC*/
+    volatile unsigned int rx_overflow;                          /*Ӧջ*/
+    volatile unsigned int rx_dropped;                           /*at_rx_pushλֽ*/
+    volatile unsigned int req_expired;                          /*Ŷӳδִе(OS汾)*/
+    volatile unsigned int tx_truncated;                         /*ʽʱضϵĸ*/
+    volatile unsigned int first_byte[AT_STATS_BUCKETS];         /*->ֽʱ*/
+    volatile unsigned int final_result[AT_STATS_BUCKETS];       /*->սʱ*/
+}at_stats_t;
+
+/*
+ * @brief	   ͳ
+ */
+static inline void at_stats_clear(at_stats_t *st)
+{
+    memset((void *)st, 0, sizeof(*st));
+}
+
+/*
+ * @brief	   ʱֱͼ
+ * @param[in]  us - ʱ(us)
+ */
+static inline void at_stats_hist(volatile unsigned int *hist, unsigned int us)
+{
+    int k = 0;
+    while (us && k < AT_STATS_BUCKETS - 1) {
+        us >>= 1;
+        k++;
+    }
+    hist[k]++;
+}
+
+#endif
@@ -0,0 +1,342 @@
+/******************************************************************************
+ * @brief        ʽʽ(̶Сķֿ黺д, Ȳ)
+ *
+ * Copyright (c) 2020, <morro_luo@163.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Morro        Initial version.
+ ******************************************************************************/
+
+#include "at_stream.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/*ʽ־ -------------------------------------------------------------------*/
+#define FMT_LEFT        0x01                          /*'-' */
+#define FMT_PLUS        0x02                          /*'+'*/
+#define FMT_SPACE       0x04                          /*' '*/
+#define FMT_ALT         0x08                          /*'#'*/
+#define FMT_ZERO        0x10                          /*'0'*/
+#define FMT_PREC        0x20                          /*ָ˾*/
+
+/*
+ * @brief       ʼ
+ * @param[in]   buf   - ֿ黺(ǰ豣Ч)
+ * @param[in]   size  - С(>0, 65535)
+ * @param[in]   sink  - ӿ
+ */
+void at_stream_init(at_stream_t *s, char *buf, unsigned int size, at_sink_t sink, void *param)
+{
+    s->sink    = sink;
+    s->param   = param;
+    s->buf     = buf;
+    s->size    = size;
+    s->len     = 0;
+    s->total   = 0;
+    s->flushes = 0;
+    s->truncated = 0;
+}
+
+/*
+ * @brief       е
+ */
+void at_stream_flush(at_stream_t *s)
+{
+    if (s->len == 0)
+        return;
+    s->sink(s->param, s->buf, s->len);
+    s->flushes++;
+    s->len = 0;
+}
+
+/*
+ * @brief       д(СڻСݿֱ)
+ */
+void at_stream_write(at_stream_t *s, const void *data, unsigned int len)
+{
+    const char *p = (const char *)data;
+    unsigned int n;
+    s->total += len;
+    if (len >= s->size) {
+        at_stream_flush(s);
+        s->sink(s->param, p, len);
+        s->flushes++;
+        return;
+    }
+    while (len > 0) {
+        n = s->size - s->len;
+        if (n > len)
+            n = len;
+        memcpy(s->buf + s->len, p, n);
+        s->len += n;
+        p      += n;
+        len    -= n;
+        if (s->len == s->size)
+            at_stream_flush(s);
+    }
+}
+
+/*
+ * @brief       дnַ
+ */
+static void pad(at_stream_t *s, char c, int n)
+{
+    static const char spaces[] = "                ";
+    static const char zeros[]  = "0000000000000000";
+    const char *p = c == '0' ? zeros : spaces;
+    while (n > 0) {
+        at_stream_write(s, p, n > 16 ? 16 : n);
+        n -= 16;
+    }
+}
+
+/*
+ * @brief       һı
+ */
+static void put_field(at_stream_t *s, const char *str, unsigned int len, int width,
+                      unsigned char flags)
+{
+    int fill = width - (int)len;
+    if (!(flags & FMT_LEFT))
+        pad(s, ' ', fill);
+    at_stream_write(s, str, len);
+    if (flags & FMT_LEFT)
+        pad(s, ' ', fill);
+}
+
+/*
+ * @brief       
+ * @param[in]   sign  - ַ, 0 - 
+ * @param[in]   conv  - תַ(d i u o x X p)
+ */
+static void put_int(at_stream_t *s, unsigned long long value, char sign, char conv,
+                    int width, int prec, unsigned char flags)
+{
+    const char *hex = conv == 'X' ? "0123456789ABCDEF" : "0123456789abcdef";
+    char tmp[24], *p = tmp + sizeof(tmp);
+    const char *prefix = "";
+    unsigned int base = conv == 'o' ? 8 : (conv == 'x' || conv == 'X' || conv == 'p') ? 16 : 10;
+    int digits, zeros, len;
+    if (!(flags & FMT_PREC))
+        prec = 1;
+    while (value != 0) {
+        *--p   = hex[value % base];
+        value /= base;
+    }
+    digits = tmp + sizeof(tmp) - p;
+    if (flags & FMT_ALT) {
+        if (base == 8 && prec <= digits && (digits == 0 || *p != '0'))
+            prec = digits + 1;                        //˽ǰ0
+        else if (base == 16 && (digits > 0 || conv == 'p'))
+            prefix = conv == 'X' ? "0X" : "0x";
+    }
+    zeros = prec > digits ? prec - digits : 0;
+    len   = (sign != 0) + strlen(prefix) + zeros + digits;
+    if ((flags & (FMT_ZERO | FMT_LEFT | FMT_PREC)) == FMT_ZERO && width > len) {
+        zeros += width - len;
+        len    = width;
+    }
+    if (!(flags & FMT_LEFT))
+        pad(s, ' ', width - len);
+    if (sign != 0)
+        at_stream_write(s, &sign, 1);
+    at_stream_write(s, prefix, strlen(prefix));
+    pad(s, '0', zeros);
+    at_stream_write(s, p, digits);
+    if (flags & FMT_LEFT)
+        pad(s, ' ', width - len);
+}
+
+/*
+ * @brief       ʽ
+ * @return      ֽ
+ */
+int at_stream_vprintf(at_stream_t *s, const char *fmt, va_list args)
+{
+    unsigned int start = s->total;
+    unsigned char flags;
+    unsigned long long u;
+    long long v;
+    int width, prec;
+    char lenmod, sign, conv, spec[16], tmp[AT_STREAM_FLOAT_SIZE];
+    const char *p, *str;
+    int n;
+    for (;;) {
+        p = strchr(fmt, '%');
+        if (p == NULL) {
+            at_stream_write(s, fmt, strlen(fmt));
+            break;
+        }
+        at_stream_write(s, fmt, p - fmt);
+        str   = p++;                                  //ת˵ʼλ
+        flags = 0;
+        for (;; p++) {                                //־
+            if (*p == '-')      flags |= FMT_LEFT;
+            else if (*p == '+') flags |= FMT_PLUS;
+            else if (*p == ' ') flags |= FMT_SPACE;
+            else if (*p == '#') flags |= FMT_ALT;
+            else if (*p == '0') flags |= FMT_ZERO;
+            else break;
+        }
+        width = 0;                                    //
+        if (*p == '*') {
+            width = va_arg(args, int);
+            if (width < 0) {
+                flags |= FMT_LEFT;
+                width  = -width;
+            }
+            p++;
+        } else {
+            while (*p >= '0' && *p <= '9')
+                width = width * 10 + (*p++ - '0');
+        }
+        prec = 0;                                     //
+        if (*p == '.') {
+            flags |= FMT_PREC;
+            if (*++p == '*') {
+                prec = va_arg(args, int);
+                if (prec < 0)
+                    flags &= ~FMT_PREC;
+                p++;
+            } else {
+                while (*p >= '0' && *p <= '9')
+                    prec = prec * 10 + (*p++ - '0');
+            }
+        }
+        lenmod = 0;                                   //('H' - hh, 'q' - ll)
+        switch (*p) {
+        case 'h':
+            lenmod = *++p == 'h' ? (p++, 'H') : 'h';
+            break;
+        case 'l':
+            lenmod = *++p == 'l' ? (p++, 'q') : 'l';
+            break;
+        case 'j': case 'z': case 't': case 'L':
+            lenmod = *p++;
+            break;
+        }
+        conv = *p;
+        if (conv == '\0') {                           //ת˵, ԭ
+            at_stream_write(s, str, p - str);
+            break;
+        }
+        fmt = p + 1;
+        switch (conv) {
+        case 'd':
+        case 'i':
+            switch (lenmod) {
+            case 'H': v = (signed char)va_arg(args, int);  break;
+            case 'h': v = (short)va_arg(args, int);        break;
+            case 'l': v = va_arg(args, long);              break;
+            case 'q': v = va_arg(args, long long);         break;
+            case 'j': v = va_arg(args, intmax_t);          break;
+            case 'z': case 't': v = va_arg(args, ptrdiff_t); break;
+            default:  v = va_arg(args, int);               break;
+            }
+            sign = v < 0 ? '-' : (flags & FMT_PLUS) ? '+' : (flags & FMT_SPACE) ? ' ' : 0;
+            u    = v < 0 ? 0ULL - (unsigned long long)v : (unsigned long long)v;
+            put_int(s, u, sign, conv, width, prec, flags);
+            break;
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+            switch (lenmod) {
+            case 'H': u = (unsigned char)va_arg(args, unsigned int);  break;
+            case 'h': u = (unsigned short)va_arg(args, unsigned int); break;
+            case 'l': u = va_arg(args, unsigned long);                break;
+            case 'q': u = va_arg(args, unsigned long long);           break;
+            case 'j': u = va_arg(args, uintmax_t);                    break;
+            case 'z': case 't': u = va_arg(args, size_t);             break;
+            default:  u = va_arg(args, unsigned int);                 break;
+            }
+            put_int(s, u, 0, conv, width, prec, flags);
+            break;
+        case 'p':
+            u = (uintptr_t)va_arg(args, void *);
+            put_int(s, u, 0, 'p', width, 0, (flags & FMT_LEFT) | FMT_ALT);
+            break;
+        case 'c':
+            tmp[0] = (char)va_arg(args, int);
+            put_field(s, tmp, 1, width, flags);
+            break;
+        case 's':
+            str = va_arg(args, const char *);
+            if (str == NULL)
+                str = "(null)";
+            if (flags & FMT_PREC) {
+                p = (const char *)memchr(str, '\0', prec);
+                n = p != NULL ? p - str : prec;
+            } else {
+                n = strlen(str);
+            }
+            put_field(s, str, n, width, flags);
+            break;
+        case 'e': case 'E':
+        case 'f': case 'F':
+        case 'g': case 'G':
+        case 'a': case 'A':
+            n = 0;                                    //ؽת˵, snprintf
+            spec[n++] = '%';
+            if (flags & FMT_LEFT)  spec[n++] = '-';
+            if (flags & FMT_PLUS)  spec[n++] = '+';
+            if (flags & FMT_SPACE) spec[n++] = ' ';
+            if (flags & FMT_ALT)   spec[n++] = '#';
+            if (flags & FMT_ZERO)  spec[n++] = '0';
+            spec[n++] = '*';
+            spec[n++] = '.';
+            spec[n++] = '*';
+            if (lenmod == 'L')
+                spec[n++] = 'L';
+            spec[n++] = conv;
+            spec[n]   = '\0';
+            if (!(flags & FMT_PREC))
+                prec = -1;
+            if (width < (int)sizeof(tmp))             //ʱput_fieldո
+                width = -width;
+            if (lenmod == 'L')
+                n = snprintf(tmp, sizeof(tmp), spec, width < 0 ? -width : 0, prec,
+                             va_arg(args, long double));
+            else
+                n = snprintf(tmp, sizeof(tmp), spec, width < 0 ? -width : 0, prec,
+                             va_arg(args, double));
+            if (n < 0) {
+                n = 0;
+            } else if (n >= (int)sizeof(tmp)) {         //"%.60f", ֻǰsizeof(tmp)-1ֽ
+                n = sizeof(tmp) - 1;
+                s->truncated++;
+            }
+            put_field(s, tmp, n, width, flags);
+            break;
+        case 'n':                                     //֧, 
+            (void)va_arg(args, void *);
+            break;
+        case '%':
+            at_stream_write(s, "%", 1);
+            break;
+        default:                                      //δ֪ת, ԭ
+            at_stream_write(s, str, fmt - str);
+            break;
+        }
+    }
+    return s->total - start;
+}
+
+/*
+ * @brief       ʽ
+ * @return      ֽ
+ */
+int at_stream_printf(at_stream_t *s, const char *fmt, ...)
+{
+    va_list args;
+    int n;
+    va_start(args, fmt);
+    n = at_stream_vprintf(s, fmt, args);
+    va_end(args);
+    return n;
+}
@@ -0,0 +1,63 @@
+/******************************************************************************
+ * @brief        ʽʽ(̶Сķֿ黺д, Ȳ)
+ *
+ * ʽдṩķֿ黺, ʱsink; 
+ * Сַ(糤URLPDU)ֱӽsink, . ջռռù̶,
+ * ޹.
+ *
+ * ֵ֧ĸʽ: %d %i %u %o %x %X %c %s %p %%  %e %f %g %a(дͬ),
+ *            ־ - + ո # 0, /(*),  hh h l ll j z t L.
+ *            ȲAT_STREAM_FLOAT_SIZE - 1, ֽض
+ *            s->truncated.
+ *
+ * ʹʾ:
+ *   at_stream_t s;
+ *   char chunk[32];
+ *   at_stream_init(&s, chunk, sizeof(chunk), sink, param);
+ *   at_stream_printf(&s, "AT+QHTTPURL=%d,%d", strlen(url), 80);
+ *   at_stream_write(&s, "\r\n", 2);
+ *   at_stream_flush(&s);
+ *
+ * Copyright (c) 2020, <morro_luo@163.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Morro        Initial version.
+ ******************************************************************************/
+
+#ifndef _AT_STREAM_H_
+#define _AT_STREAM_H_
+
+#include "at_util.h"
+#include <stdarg.h>
+#include <stdbool.h>
+
+#ifndef AT_STREAM_FLOAT_SIZE
+#define AT_STREAM_FLOAT_SIZE    48                              /*ʽС*/
+#endif
+
+/* ---------------------------------------------------------------------*/
+typedef struct {
+    at_sink_t           sink;                                   /*ӿ*/
+    void               *param;                                  /*sink*/
+    char               *buf;                                    /*ֿ黺*/
+    unsigned short      size;                                   /*ֿ黺С*/
+    unsigned short      len;                                    /*дֽ*/
+    unsigned int        total;                                  /*дֽ()*/
+    unsigned short      flushes;                                /*sinkô*/
+    unsigned short      truncated;                              /*ضϵĸ*/
+}at_stream_t;
+
+void at_stream_init(at_stream_t *s, char *buf, unsigned int size, at_sink_t sink, void *param);
+
+void at_stream_write(at_stream_t *s, const void *data, unsigned int len);
+
+int  at_stream_vprintf(at_stream_t *s, const char *fmt, va_list args);
+
+int  at_stream_printf(at_stream_t *s, const char *fmt, ...);
+
+void at_stream_flush(at_stream_t *s);
+
+#endif
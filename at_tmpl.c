@@ -0,0 +1,173 @@
+/******************************************************************************
+ * @brief        ATģ(һ, ʱʽʹñ)
+ *
+ * Copyright (c) 2020, <morro_luo@163.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Morro        Initial version.
+ ******************************************************************************/
+
+#include "at_tmpl.h"
+#include <string.h>
+
+/*λʮֱ, ÿγλ -----------------------------------------*/
+static const char digits2[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/*
+ * @brief       ģ
+ * @param[in]   fmt - ģ崮("AT+CGDCONT=%d,\"IP\",%q"), ʹڼ豣Ч
+ * @return      false - ʽ
+ */
+bool at_tmpl_compile(at_tmpl_t *t, const char *fmt)
+{
+    const char *s = fmt, *p;
+    t->fmt   = fmt;
+    t->count = 0;
+    while ((p = strchr(s, '%')) != NULL) {
+        if (t->count >= AT_TMPL_SLOTS || p - s > 0xFF)
+            return false;
+        switch (p[1]) {
+        case 'd': case 'u': case 'x': case 'X':
+        case 's': case 'q': case 'b':
+            t->lit[t->count] = s;
+            t->len[t->count] = p - s;
+            break;
+        case '%':                                     //ΰһ'%'
+            t->lit[t->count] = s;
+            t->len[t->count] = p + 1 - s;
+            break;
+        default:
+            return false;
+        }
+        t->type[t->count++] = p[1];
+        s = p + 2;
+    }
+    if (strlen(s) > 0xFF)
+        return false;
+    t->lit[t->count] = s;
+    t->len[t->count] = strlen(s);
+    return true;
+}
+
+/*
+ * @brief       ("\r\n")ķɢдݿ
+ * @param[in]   args - (˳Ӧģг%%Ĳλ)
+ * @param[out]  iov  - ݿ, AT_TMPL_IOV_MAX
+ * @param[in]   num  - ֵʽ, AT_TMPL_NUM_SIZEֽ, ǰ豣Ч
+ * @return      ݿ
+ */
+int at_tmpl_render(const at_tmpl_t *t, const at_arg_t *args, at_iovec_t *iov, char *num)
+{
+    int k, n = 0;
+    unsigned int len;
+    const char *s;
+    for (k = 0; ; k++) {
+        if (t->len[k] > 0) {
+            iov[n].base  = t->lit[k];
+            iov[n++].len = t->len[k];
+        }
+        if (k >= t->count)
+            break;
+        switch (t->type[k]) {
+        case 'd':
+        case 'u':
+        case 'x':
+        case 'X':
+            if (t->type[k] == 'd')
+                len = at_fmt_int(num, args->i);
+            else if (t->type[k] == 'u')
+                len = at_fmt_uint(num, args->u);
+            else
+                len = at_fmt_hex(num, args->u, t->type[k] == 'X');
+            iov[n].base  = num;
+            iov[n++].len = len;
+            num += len;
+            break;
+        case 'q':
+        case 's':
+            s = args->s != NULL ? args->s : "";
+            if (t->type[k] == 'q') {
+                iov[n].base  = "\"";
+                iov[n++].len = 1;
+            }
+            iov[n].base  = s;
+            iov[n++].len = strlen(s);
+            if (t->type[k] == 'q') {
+                iov[n].base  = "\"";
+                iov[n++].len = 1;
+            }
+            break;
+        case 'b':
+            iov[n].base  = args->b.p;
+            iov[n++].len = args->b.len;
+            break;
+        default:                                      //%%, ռ
+            continue;
+        }
+        args++;
+    }
+    iov[n].base  = "\r\n";
+    iov[n++].len = 2;
+    return n;
+}
+
+/*
+ * @brief       ޷ʽ
+ * @return      (10ֽ)
+ */
+unsigned int at_fmt_uint(char *buf, unsigned int value)
+{
+    char tmp[10], *p = tmp + sizeof(tmp);
+    unsigned int r, n;
+    while (value >= 100) {
+        r      = (value % 100) * 2;
+        value /= 100;
+        *--p   = digits2[r + 1];
+        *--p   = digits2[r];
+    }
+    if (value >= 10) {
+        *--p = digits2[value * 2 + 1];
+        *--p = digits2[value * 2];
+    } else {
+        *--p = '0' + value;
+    }
+    n = tmp + sizeof(tmp) - p;
+    memcpy(buf, p, n);
+    return n;
+}
+
+/*
+ * @brief       зʽ
+ * @return      (11ֽ)
+ */
+unsigned int at_fmt_int(char *buf, int value)
+{
+    if (value >= 0)
+        return at_fmt_uint(buf, (unsigned int)value);
+    *buf = '-';
+    return 1 + at_fmt_uint(buf + 1, 0u - (unsigned int)value);
+}
+
+/*
+ * @brief       ʮƸʽ(ǰ0)
+ * @return      (8ֽ)
+ */
+unsigned int at_fmt_hex(char *buf, unsigned int value, bool upper)
+{
+    const char *hex = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char tmp[8], *p = tmp + sizeof(tmp);
+    unsigned int n;
+    do {
+        *--p    = hex[value & 0x0F];
+        value >>= 4;
+    } while (value != 0);
+    n = tmp + sizeof(tmp) - p;
+    memcpy(buf, p, n);
+    return n;
+}
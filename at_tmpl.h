@@ -0,0 +1,75 @@
+/******************************************************************************
+ * @brief        ATģ(һ, ʱʽʹñ)
+ *
+ * ģ崮еĲ:
+ *   %d - з     %u - ޷     %x/%X - ʮ(Сд/д)
+ *   %s - ַ         %q - ŵַ %b - ԭʼֽ(ָ+)
+ *   %% - ַ'%'(ռ)
+ * ʱֱģ崮, ֱַõ, ֵֻʽ,
+ * Էɢд(iovec)ʽύ.
+ *
+ * ʹʾ:
+ *   static at_tmpl_t cgdcont;
+ *   at_tmpl_compile(&cgdcont, "AT+CGDCONT=%d,\"IP\",%q");
+ *   ...
+ *   at_arg_t args[] = {AT_ARG_INT(1), AT_ARG_STR("cmnet")};
+ *   at_do_cmd_tmpl(&at, &resp, &cgdcont, args);
+ *
+ * Copyright (c) 2020, <morro_luo@163.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Morro        Initial version.
+ ******************************************************************************/
+
+#ifndef _AT_TMPL_H_
+#define _AT_TMPL_H_
+
+#include "at_util.h"
+#include <stdbool.h>
+
+#ifndef AT_TMPL_SLOTS
+#define AT_TMPL_SLOTS           6                               /*ģ*/
+#endif
+
+#define AT_TMPL_IOV_MAX         (AT_TMPL_SLOTS * 4 + 2)         /*at_tmpl_renderiovec*/
+#define AT_TMPL_NUM_SIZE        (AT_TMPL_SLOTS * 11)            /*ֵʽС*/
+
+/*ģ -------------------------------------------------------------------*/
+typedef union {
+    int                 i;                                      /*%d*/
+    unsigned int        u;                                      /*%u %x %X*/
+    const char         *s;                                      /*%s %q*/
+    struct {
+        const void     *p;
+        unsigned int    len;
+    }b;                                                         /*%b*/
+}at_arg_t;
+
+#define AT_ARG_INT(v)           {.i = (v)}
+#define AT_ARG_UINT(v)          {.u = (v)}
+#define AT_ARG_STR(v)           {.s = (v)}
+#define AT_ARG_RAW(p, n)        {.b = {(p), (n)}}
+
+/*ģ -------------------------------------------------------------------*/
+typedef struct {
+    const char         *fmt;                                    /*ģ崮(豣Ч)*/
+    const char         *lit[AT_TMPL_SLOTS + 1];                 /*(ָģ崮)*/
+    unsigned char       len[AT_TMPL_SLOTS + 1];                 /*γ*/
+    char                type[AT_TMPL_SLOTS];                    /*֮Ĳ*/
+    unsigned char       count;                                  /*λ(%%)*/
+}at_tmpl_t;
+
+bool at_tmpl_compile(at_tmpl_t *t, const char *fmt);
+
+int  at_tmpl_render(const at_tmpl_t *t, const at_arg_t *args, at_iovec_t *iov, char *num);
+
+unsigned int at_fmt_uint(char *buf, unsigned int value);       /*ʽ('\0'β)*/
+
+unsigned int at_fmt_int(char *buf, int value);
+
+unsigned int at_fmt_hex(char *buf, unsigned int value, bool upper);
+
+#endif
@@ -19,6 +19,15 @@
 
 typedef struct os_semaphore at_sem_t;                                /*ź*/
 
+/*ɢдݿ ---------------------------------------------------------------*/
+typedef struct {
+    const void   *base;
+    unsigned int  len;
+}at_iovec_t;
+
+/*ݽ -----------------------------------------------------------------*/
+typedef void (*at_sink_t)(void *param, const void *buf, unsigned int len);
+
 /*
  * @brief	   ȡǰϵͳ
  */
@@ -26,6 +35,19 @@ static inline unsigned int at_get_ms(void)
 {
     return ril_get_ms();
 }
+/*
+ * @brief	   ȡǰϵͳ΢(ʱͳ)
+ * @note       os.hṩril_get_usʱAT_USE_US_CLOCK, 򰴺뻻
+ */
+static inline unsigned int at_get_us(void)
+{
+#ifdef AT_USE_US_CLOCK
+    return ril_get_us();
+#else
+    return ril_get_ms() * 1000;
+#endif
+}
+
 /*
  * @brief	   ʱж
  * @retval     true | false
@@ -69,4 +91,13 @@ static inline void at_sem_post(at_sem_t *s)
     os_sem_post(s);
 }
 
+/*
+ * @brief	   ź(ʱź)
+ * @retval     none
+ */
+static inline void at_sem_destroy(at_sem_t *s)
+{
+    os_sem_destroy(s);
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,206 @@
+/******************************************************************************
+ * @brief        at_chat˵ܲ(ģmodem, Linux)
+ *
+ * (ڲֿĿ¼):
+ *   gcc -O2 -pthread -I. -Ibench -Iport/posix bench/bench_chat.c bench/sim_modem.c \
+ *       port/posix/os.c at_chat.c at_match.c at_prefix.c at_parse.c at_latency.c \
+ *       at_tmpl.c at_stream.c -o bench_chat
+ *
+ * : ./bench_chat [] [URC] [Ӧӳus]
+ *
+ * Copyright (c) 2020, <morro_luo@163.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Morro        Initial version.
+ ******************************************************************************/
+
+#include "at_chat.h"
+#include "sim_modem.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static sim_modem_t   modem;
+static at_obj_t      at;
+
+static unsigned char urc_buf[128];
+static unsigned char rcv_buf[8192];
+static unsigned char rx_buf[1024];
+
+static unsigned int  done_cnt, fail_cnt, urc_cnt;
+
+static sim_rule_t rules[] = {
+    {"AT+CSQ",  "+CSQ: 24,99"},
+    {"AT+CREG", "+CREG: 0,1"},
+    {"AT+CMGL", "+CMGL: 1,\"REC READ\",\"+8613800000000\",,\"20/01/02,10:00:00+32\"",
+                NULL, 0, 100},
+    {"AT",      NULL},
+};
+
+static unsigned int bench_write(const void *buf, unsigned int len)
+{
+    return sim_write(&modem, buf, len);
+}
+
+static unsigned int bench_read(void *buf, unsigned int len)
+{
+    return sim_read(&modem, buf, len);
+}
+
+static void creg_handler(char *recvbuf, int size)
+{
+    urc_cnt++;
+}
+
+static utc_item_t utc_tbl[] = {
+    {"+CREG:", creg_handler},
+};
+
+static void cmd_callback(at_response_t *r)
+{
+    if (r->ret == AT_RET_OK)
+        done_cnt++;
+    else
+        fail_cnt++;
+}
+
+/*ʱ -----------------------------------------------------------------------*/
+typedef struct {
+    double wall, cpu;                                           /**/
+}bench_time_t;
+
+static double clock_sec(clockid_t id)
+{
+    struct timespec ts;
+    clock_gettime(id, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void bench_start(bench_time_t *t)
+{
+    t->wall = clock_sec(CLOCK_MONOTONIC);
+    t->cpu  = clock_sec(CLOCK_PROCESS_CPUTIME_ID);
+}
+
+static void bench_stop(bench_time_t *t)
+{
+    t->wall = clock_sec(CLOCK_MONOTONIC) - t->wall;
+    t->cpu  = clock_sec(CLOCK_PROCESS_CPUTIME_ID) - t->cpu;
+}
+
+/*
+ * @brief       ִе
+ */
+static void run_cmds(const char *name, const char *cmd, unsigned int total)
+{
+    bench_time_t t;
+    unsigned int sent = 0;
+    unsigned long long bytes = modem.tx_bytes + modem.rx_bytes;
+    done_cnt = fail_cnt = 0;
+    bench_start(&t);
+    while (done_cnt + fail_cnt < total) {
+        while (sent < total && at_send_singlline(&at, cmd_callback, cmd))
+            sent++;
+        at_poll_task(&at);
+    }
+    bench_stop(&t);
+    bytes = modem.tx_bytes + modem.rx_bytes - bytes;
+    printf("%-8s %8u cmds %6u fail %10.0f cmds/s %12.0f bytes/s %8.2f us cpu/cmd\n",
+           name, total, fail_cnt, total / t.wall, bytes / t.wall, t.cpu * 1e6 / total);
+}
+
+/*
+ * @brief       ֹҵ: (ھбֹ) / һֱȴ(ִбֹ)
+ */
+static int sleep_job(at_job_t *j)
+{
+    AT_JOB_BEGIN(j);
+    AT_JOB_SLEEP(j, 60000);
+    AT_JOB_END(j);
+}
+
+static int stall_job(at_job_t *j)
+{
+    AT_JOB_BEGIN(j);
+    AT_JOB_WAIT_UNTIL(j, false);
+    AT_JOB_END(j);
+}
+
+/*
+ * @brief       ֹҵstats.cmd[AT_RET_ABORT]
+ * @return      false - 
+ */
+static bool run_abort(void)
+{
+    unsigned int base = at.stats.cmd[AT_RET_ABORT];
+    at_do_job(&at, sleep_job, NULL);
+    at_poll_task(&at);                                          //, ھ
+    at_item_abort(list_first_entry(&at.ls_ready, at_item_t, node));
+    at_poll_task(&at);
+    at_do_job(&at, stall_job, NULL);
+    at_poll_task(&at);                                          //Ϊǰҵ
+    at_item_abort(at.cursor);
+    at_poll_task(&at);
+    printf("%-8s %8u jobs %6u busy %10u aborted\n", "abort", 2, at_obj_busy(&at),
+           at.stats.cmd[AT_RET_ABORT] - base);
+    return !at_obj_busy(&at) && at.stats.cmd[AT_RET_ABORT] - base == 2;
+}
+
+/*
+ * @brief       URC籩
+ */
+static void run_urcs(unsigned int total)
+{
+    bench_time_t t;
+    unsigned long long bytes = modem.tx_bytes;
+    urc_cnt = 0;
+    sim_urc(&modem, "+CREG: 1", total);
+    bench_start(&t);
+    while (!sim_idle(&modem))
+        at_poll_task(&at);
+    at_poll_task(&at);
+    bench_stop(&t);
+    bytes = modem.tx_bytes - bytes;
+    printf("%-8s %8u urcs %6u lost %10.0f urcs/s %12.0f bytes/s %8.2f us cpu/urc\n",
+           "urc", total, total - urc_cnt, urc_cnt / t.wall, bytes / t.wall,
+           t.cpu * 1e6 / total);
+}
+
+int main(int argc, char *argv[])
+{
+    at_obj_conf_t cfg = {0};
+    unsigned int cmds    = argc > 1 ? atoi(argv[1]) : 100000;
+    unsigned int urcs    = argc > 2 ? atoi(argv[2]) : 100000;
+    unsigned int latency = argc > 3 ? atoi(argv[3]) : 0;
+    unsigned int i;
+
+    for (i = 0; i < sizeof(rules) / sizeof(rules[0]); i++)
+        rules[i].latency = latency;
+    sim_init(&modem, rules, sizeof(rules) / sizeof(rules[0]), true);
+
+    cfg.write         = bench_write;
+    cfg.read          = bench_read;
+    cfg.utc_tbl       = utc_tbl;
+    cfg.urc_tbl_count = sizeof(utc_tbl) / sizeof(utc_tbl[0]);
+    cfg.urc_buf       = urc_buf;
+    cfg.urc_bufsize   = sizeof(urc_buf);
+    cfg.rcv_buf       = rcv_buf;
+    cfg.rcv_bufsize   = sizeof(rcv_buf);
+    cfg.rx_buf        = rx_buf;
+    cfg.rx_bufsize    = sizeof(rx_buf);
+    at_obj_init(&at, cfg);
+
+    run_cmds("AT", "AT", cmds);
+    run_cmds("AT+CSQ", "AT+CSQ", cmds);
+    run_cmds("AT+CMGL", "AT+CMGL=4", cmds / 100 + 1);
+    run_urcs(urcs);
+    if (!run_abort())
+        return 1;
+    printf("at_stats: rx %u bytes, tx %u bytes, rx overflow %u, urc dropped %u\n",
+           at.stats.rx_bytes, at.stats.tx_bytes, at.stats.rx_overflow,
+           at.stats.urc_dropped);
+    return 0;
+}
@@ -0,0 +1,187 @@
+/******************************************************************************
+ * @brief        ģmodem(űӦ, עURC, Ӳܲ)
+ *
+ * Copyright (c) 2020, <morro_luo@163.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Morro        Initial version.
+ ******************************************************************************/
+
+#include "sim_modem.h"
+#include <string.h>
+#include <time.h>
+
+/*
+ * @brief       ȡʱ(us)
+ */
+static unsigned int sim_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned int)(ts.tv_sec * 1000000ull + ts.tv_nsec / 1000);
+}
+
+/*
+ * @brief       ʼģmodem
+ * @param[in]   rules - Ӧ(˳ƥǰ׺, ƥʱӦ"ERROR")
+ * @param[in]   echo  - Ƿ
+ */
+void sim_init(sim_modem_t *m, const sim_rule_t *rules, unsigned short count, bool echo)
+{
+    memset(m, 0, sizeof(*m));
+    m->rules      = rules;
+    m->rule_count = count;
+    m->echo       = echo;
+}
+
+/*
+ * @brief       г
+ */
+static unsigned int out_space(const sim_modem_t *m)
+{
+    return SIM_OUTBUF_SIZE - 1 - (m->head - m->tail + SIM_OUTBUF_SIZE) % SIM_OUTBUF_SIZE;
+}
+
+/*
+ * @brief       д(ռ䲻ʱ, ʵһ)
+ */
+static void out_put(sim_modem_t *m, const char *s, unsigned int len)
+{
+    if (len > out_space(m))
+        return;
+    while (len--) {
+        m->out[m->head] = *s++;
+        m->head = (m->head + 1) % SIM_OUTBUF_SIZE;
+    }
+}
+
+/*
+ * @brief       һ("\r\n<line>\r\n")
+ */
+static void out_line(sim_modem_t *m, const char *line)
+{
+    out_put(m, "\r\n", 2);
+    out_put(m, line, strlen(line));
+    out_put(m, "\r\n", 2);
+}
+
+/*
+ * @brief       һ
+ */
+static void cmd_process(sim_modem_t *m)
+{
+    const sim_rule_t *r = NULL;
+    sim_job_t *j = &m->resp;
+    int i;
+    m->line[m->line_len] = '\0';
+    m->cmds++;
+    if (m->echo) {
+        out_put(m, m->line, m->line_len);
+        out_put(m, "\r", 1);
+    }
+    for (i = 0; i < m->rule_count; i++) {
+        if (strncmp(m->line, m->rules[i].cmd, strlen(m->rules[i].cmd)) == 0) {
+            r = &m->rules[i];
+            break;
+        }
+    }
+    if (r == NULL) {
+        j->line  = NULL;
+        j->left  = 0;
+        j->final = "ERROR";
+        j->due   = sim_now_us();
+        return;
+    }
+    j->line  = r->reply;
+    j->left  = r->reply == NULL ? 0 : r->repeat ? r->repeat : 1;
+    j->final = r->final ? r->final : "OK";
+    j->due   = sim_now_us() + r->latency;
+}
+
+/*
+ * @brief       д(Ӧat_obj_conf_t.write)
+ * @details     '\r', '\n'
+ */
+unsigned int sim_write(sim_modem_t *m, const void *buf, unsigned int len)
+{
+    const char *s = (const char *)buf;
+    unsigned int i;
+    m->rx_bytes += len;
+    for (i = 0; i < len; i++) {
+        if (s[i] == '\r') {
+            if (m->line_len > 0)
+                cmd_process(m);
+            m->line_len = 0;
+        } else if (s[i] != '\n' && m->line_len < SIM_LINE_MAX - 1) {
+            m->line[m->line_len++] = s[i];
+        }
+    }
+    return len;
+}
+
+/*
+ * @brief       ҵһ
+ * @return      false - ҵδ
+ */
+static bool job_step(sim_modem_t *m, sim_job_t *j, unsigned int now)
+{
+    if ((j->left == 0 && j->final == NULL) || (int)(now - j->due) < 0)
+        return false;
+    if (j->left > 0) {
+        out_line(m, j->line);
+        j->left--;
+    } else {
+        out_line(m, j->final);
+        j->final = NULL;
+    }
+    return true;
+}
+
+/*
+ * @brief       ȡ(Ӧat_obj_conf_t.read)
+ * @details     ȡʱӦURC(߽, ģURCӦм)
+ */
+unsigned int sim_read(sim_modem_t *m, void *buf, unsigned int len)
+{
+    char *d = (char *)buf;
+    unsigned int n = 0, now = sim_now_us();
+    sim_job_t *first, *second;
+    while (out_space(m) > SIM_LINE_MAX + 4) {
+        first  = m->turn ? &m->urc : &m->resp;
+        second = m->turn ? &m->resp : &m->urc;
+        m->turn ^= 1;
+        if (!job_step(m, first, now) && !job_step(m, second, now))
+            break;
+    }
+    while (n < len && m->tail != m->head) {
+        d[n++]  = m->out[m->tail];
+        m->tail = (m->tail + 1) % SIM_OUTBUF_SIZE;
+    }
+    m->tx_bytes += n;
+    return n;
+}
+
+/*
+ * @brief       עURC
+ * @param[in]   urc   - URC("+CREG: 1"), 뱣Чֱ
+ * @param[in]   count - ظ(URC籩)
+ */
+void sim_urc(sim_modem_t *m, const char *urc, unsigned int count)
+{
+    m->urc.line  = urc;
+    m->urc.left  = count;
+    m->urc.final = NULL;
+    m->urc.due   = sim_now_us();
+}
+
+/*
+ * @brief       жǷѱȡ
+ */
+bool sim_idle(const sim_modem_t *m)
+{
+    return m->head == m->tail && m->resp.left == 0 && m->resp.final == NULL &&
+           m->urc.left == 0;
+}
@@ -0,0 +1,68 @@
+/******************************************************************************
+ * @brief        ģmodem(űӦ, עURC, Ӳܲ)
+ *
+ * Copyright (c) 2020, <morro_luo@163.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Morro        Initial version.
+ ******************************************************************************/
+
+#ifndef _SIM_MODEM_H_
+#define _SIM_MODEM_H_
+
+#include <stdbool.h>
+
+#ifndef SIM_OUTBUF_SIZE
+#define SIM_OUTBUF_SIZE         4096                            /*С*/
+#endif
+
+#define SIM_LINE_MAX            256                             /*󳤶*/
+
+/*Ӧ -------------------------------------------------------------------*/
+typedef struct {
+    const char     *cmd;                                        /*ǰ׺("AT+CSQ")*/
+    const char     *reply;                                      /*Ϣ(), ΪNULL*/
+    const char     *final;                                      /*, NULL - "OK"*/
+    unsigned int    latency;                                    /*Ӧӳ(us)*/
+    unsigned int    repeat;                                     /*Ϣظ(Ӧ), 0ͬ1*/
+}sim_rule_t;
+
+/*ҵ(Ӧ/URC, Ӧռû) ---------------------------*/
+typedef struct {
+    const char     *line;                                       /*ǰ*/
+    const char     *final;                                      /*Ľ*/
+    unsigned int    left;                                       /*ʣ*/
+    unsigned int    due;                                        /*ʼʱ(us)*/
+}sim_job_t;
+
+/*ģmodem ------------------------------------------------------------------*/
+typedef struct {
+    const sim_rule_t *rules;
+    unsigned short  rule_count;
+    unsigned char   echo;                                       /*(ATE1)*/
+    char            line[SIM_LINE_MAX];                         /*ջ*/
+    unsigned short  line_len;
+    char            out[SIM_OUTBUF_SIZE];                       /*λ*/
+    unsigned int    head, tail;
+    sim_job_t       resp;                                       /*Ӧ*/
+    sim_job_t       urc;                                        /*URCע*/
+    unsigned char   turn;                                       /*ӦURC*/
+    /*ͳ -------------------------------------------------------------------*/
+    unsigned int    cmds;                                       /*յ*/
+    unsigned long long rx_bytes, tx_bytes;                      /*modem/ֽ*/
+}sim_modem_t;
+
+void sim_init(sim_modem_t *m, const sim_rule_t *rules, unsigned short count, bool echo);
+
+unsigned int sim_write(sim_modem_t *m, const void *buf, unsigned int len);
+
+unsigned int sim_read(sim_modem_t *m, void *buf, unsigned int len);
+
+void sim_urc(sim_modem_t *m, const char *urc, unsigned int count);
+
+bool sim_idle(const sim_modem_t *m);
+
+#endif
@@ -0,0 +1,281 @@
+/******************************************************************************
+ * @brief        ATepollӦ(Linux), ̷߳ϵat_obj_t
+ *
+ * Copyright (c) 2020, <morro_luo@163.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Morro        Initial version.
+ ******************************************************************************/
+
+#define _GNU_SOURCE
+
+#include "at_reactor.h"
+#include <errno.h>
+#include <stdint.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+/*
+ * @brief       ޸fd¼
+ */
+static void watch(at_reactor_t *r, at_reactor_item_t *it, unsigned int events)
+{
+    struct epoll_event ev;
+    ev.events   = events;
+    ev.data.ptr = it;
+    epoll_ctl(r->epfd, EPOLL_CTL_MOD, it->fd, &ev);
+}
+
+/*
+ * @brief       /Ƴ
+ */
+static void set_active(at_reactor_t *r, at_reactor_item_t *it, bool active)
+{
+    if (active && !it->active)
+        list_add_tail(&it->node, &r->active);
+    else if (!active && it->active)
+        list_del(&it->node);
+    it->active = active;
+}
+
+/*
+ * @brief       (ݻʱ)
+ * @param[in]   readable - fdɶ
+ */
+static void service(at_reactor_t *r, at_reactor_item_t *it, bool readable)
+{
+    if (!at_obj_process(it->at, readable)) {          //ҵģʽ, at_do_workȡ
+        if (!it->paused) {
+            watch(r, it, 0);                          //ˮƽ, ͣת
+            it->paused = 1;
+        }
+        set_active(r, it, true);
+        return;
+    }
+    if (it->paused) {
+        watch(r, it, EPOLLIN);
+        it->paused = 0;
+    }
+    set_active(r, it, at_obj_deadline(it->at) != AT_NO_TIMEOUT);
+}
+
+/*
+ * @brief       ATѽӿ(̵߳, 緢첽at_suspend)
+ */
+static void item_wake(void *param)
+{
+    at_reactor_item_t *it = (at_reactor_item_t *)param;
+    at_reactor_t *r = it->r;
+    uint64_t one = 1;
+    while (!at_sem_wait(&r->wlock, AT_IDLE_WAIT)) {}
+    if (!it->woken) {
+        list_add_tail(&it->wnode, &r->woken);
+        it->woken = 1;
+    }
+    at_sem_post(&r->wlock);
+    if (write(r->efd, &one, sizeof(one)) < 0) {}      //ѷ0ʱд
+}
+
+/*
+ * @brief       ̻߳ѵĶ
+ */
+static void wake_process(at_reactor_t *r)
+{
+    at_reactor_item_t *it;
+    uint64_t ticks;
+    if (read(r->efd, &ticks, sizeof(ticks)) < 0) {}
+    while (!at_sem_wait(&r->wlock, AT_IDLE_WAIT)) {}
+    while (!list_empty(&r->woken)) {
+        it = list_first_entry(&r->woken, at_reactor_item_t, wnode);
+        list_del(&it->wnode);
+        it->woken = 0;
+        at_sem_post(&r->wlock);
+        service(r, it, false);                        //, ֹ
+        while (!at_sem_wait(&r->wlock, AT_IDLE_WAIT)) {}
+    }
+    at_sem_post(&r->wlock);
+}
+
+/*
+ * @brief       ĳʱʱöʱ
+ */
+static void timer_update(at_reactor_t *r)
+{
+    struct itimerspec its = {{0, 0}, {0, 0}};
+    struct list_head *list, *n;
+    at_reactor_item_t *it;
+    unsigned int t, min = AT_NO_TIMEOUT;
+    list_for_each_safe(list, n, &r->active) {
+        it = list_entry(list, at_reactor_item_t, node);
+        t  = it->paused ? AT_REACTOR_WORK_POLL : at_obj_deadline(it->at);
+        if (t == AT_NO_TIMEOUT)                       //ɵ߳̽
+            set_active(r, it, false);
+        else if (t < min)
+            min = t;
+    }
+    if (min == AT_NO_TIMEOUT) {
+        if (r->armed)
+            timerfd_settime(r->tfd, 0, &its, NULL);   //ֹͣʱ
+        r->armed = 0;
+        return;
+    }
+    if (r->armed && r->due == at_get_ms() + min)      //ʱ̲
+        return;
+    r->due    = at_get_ms() + min;
+    r->armed  = 1;
+    its.it_value.tv_sec  = min / 1000;
+    its.it_value.tv_nsec = (long)(min % 1000) * 1000000L;
+    if (min == 0)
+        its.it_value.tv_nsec = 1;                     //ȫ0ʾֹͣʱ
+    timerfd_settime(r->tfd, 0, &its, NULL);
+}
+
+/*
+ * @brief       ʼӦ
+ * @return      false - epolltimerfdʧ(errnoָʾԭ)
+ */
+bool at_reactor_init(at_reactor_t *r)
+{
+    struct epoll_event ev;
+    INIT_LIST_HEAD(&r->active);
+    INIT_LIST_HEAD(&r->woken);
+    at_sem_init(&r->wlock, 1);
+    r->count   = 0;
+    r->armed   = 0;
+    r->wakeups = r->timer_fires = 0;
+    r->tfd     = r->efd = -1;
+    r->epfd    = epoll_create1(EPOLL_CLOEXEC);
+    if (r->epfd < 0)
+        return false;
+    r->tfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    r->efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (r->tfd < 0 || r->efd < 0)
+        goto fail;
+    ev.events   = EPOLLIN;
+    ev.data.ptr = NULL;                               //ʱ¼
+    if (epoll_ctl(r->epfd, EPOLL_CTL_ADD, r->tfd, &ev) != 0)
+        goto fail;
+    ev.data.ptr = r;                                  //¼
+    if (epoll_ctl(r->epfd, EPOLL_CTL_ADD, r->efd, &ev) == 0)
+        return true;
+fail:
+    at_reactor_deinit(r);
+    return false;
+}
+
+/*
+ * @brief       ͷŷӦ(رնfd)
+ */
+void at_reactor_deinit(at_reactor_t *r)
+{
+    if (r->efd >= 0)
+        close(r->efd);
+    if (r->tfd >= 0)
+        close(r->tfd);
+    if (r->epfd >= 0)
+        close(r->epfd);
+    r->epfd = r->tfd = r->efd = -1;
+}
+
+/*
+ * @brief       AT(ԭ߳, ɷӦ)
+ * @param[in]   it - (ṩ, Ƴǰ豣Ч)
+ * @param[in]   fd - Ĵfd()
+ * @return      false - עepollʧ
+ */
+bool at_reactor_add(at_reactor_t *r, at_reactor_item_t *it, at_obj_t *at, int fd)
+{
+    struct epoll_event ev;
+    it->r      = r;
+    it->at     = at;
+    it->fd     = fd;
+    it->active = it->paused = it->hangup = it->woken = 0;
+    ev.events   = EPOLLIN;
+    ev.data.ptr = it;
+    if (epoll_ctl(r->epfd, EPOLL_CTL_ADD, fd, &ev) != 0)
+        return false;
+    at_reader_detach(at);
+    at_obj_set_wake(at, item_wake, it);
+    r->count++;
+    service(r, it, true);                             //עǰѵ
+    timer_update(r);
+    return true;
+}
+
+/*
+ * @brief       ƳAT
+ */
+void at_reactor_del(at_reactor_t *r, at_reactor_item_t *it)
+{
+    if (!it->hangup)
+        epoll_ctl(r->epfd, EPOLL_CTL_DEL, it->fd, NULL);
+    at_obj_set_wake(it->at, NULL, NULL);
+    while (!at_sem_wait(&r->wlock, AT_IDLE_WAIT)) {}
+    if (it->woken)
+        list_del(&it->wnode);
+    it->woken = 0;
+    at_sem_post(&r->wlock);
+    set_active(r, it, false);
+    r->count--;
+}
+
+/*
+ * @brief       ִһ¼
+ * @param[in]   timeout - ȴʱ(ms), -1 - һֱȴ
+ * @return      ¼, -1 - epoll
+ */
+int at_reactor_poll(at_reactor_t *r, int timeout)
+{
+    struct epoll_event events[AT_REACTOR_EVENTS];
+    struct list_head *list, *n;
+    at_reactor_item_t *it;
+    bool expired = false;
+    uint64_t ticks;
+    int i, count;
+    count = epoll_wait(r->epfd, events, AT_REACTOR_EVENTS, timeout);
+    if (count < 0)
+        return errno == EINTR ? 0 : -1;
+    r->wakeups++;
+    for (i = 0; i < count; i++) {
+        it = (at_reactor_item_t *)events[i].data.ptr;
+        if (it == NULL) {                             //ʱ
+            if (read(r->tfd, &ticks, sizeof(ticks)) > 0)
+                r->timer_fires++;
+            r->armed = 0;
+            expired  = true;
+            continue;
+        }
+        if (it == (at_reactor_item_t *)r) {           //̻߳
+            wake_process(r);
+            continue;
+        }
+        if (events[i].events & EPOLLIN)
+            service(r, it, true);
+        if ((events[i].events & (EPOLLHUP | EPOLLERR)) && !it->hangup) {
+            epoll_ctl(r->epfd, EPOLL_CTL_DEL, it->fd, NULL);
+            it->hangup = 1;                           //豸γ, ˮƽ±ת
+            it->at->cfg.debug("reactor: fd %d hangup\r\n", it->fd);
+        }
+    }
+    if (expired) {                                    //ֻдⳬʱĶ
+        list_for_each_safe(list, n, &r->active) {
+            it = list_entry(list, at_reactor_item_t, node);
+            service(r, it, false);
+        }
+    }
+    timer_update(r);
+    return count;
+}
+
+/*
+ * @brief       Ӧѭ
+ */
+void at_reactor_run(at_reactor_t *r)
+{
+    while (at_reactor_poll(r, -1) >= 0) {}
+}
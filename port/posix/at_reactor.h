@@ -0,0 +1,88 @@
+/******************************************************************************
+ * @brief        ATepollӦ(Linux), ̷߳ϵat_obj_t
+ *
+ * ÿATfdעᵽepoll, ֻݿɶĶ; дⳬʱ(URC/
+ * /Ӧ)Ķ, timerfdʱĳʱʱ. жռ
+ * CPU, Ѵض޹.
+ *
+ * ʹʾ:
+ *   static at_reactor_t      reactor;
+ *   static at_reactor_item_t items[MODEM_COUNT];
+ *   at_reactor_init(&reactor);
+ *   for (i = 0; i < MODEM_COUNT; i++)
+ *       at_reactor_add(&reactor, &items[i], &modem[i].at, modem[i].serial.fd);
+ *   at_reactor_run(&reactor);                                  //Ӧ߳
+ *
+ * ̷߳첽at_suspendʱ, ͨeventfdѷӦ¼ʱ.
+ *
+ * ע:
+ *   1. Էʽ(at_serial_conf_t.nonblock = 1).
+ *   2. at_reactor_add/at_reactor_delڷӦ߳ʱ, Ӧ֤Ӧδ.
+ *   3. : gcc ... -I. -Iport/posix port/posix/at_reactor.c
+ *
+ * Copyright (c) 2020, <morro_luo@163.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Morro        Initial version.
+ ******************************************************************************/
+
+#ifndef _AT_REACTOR_H_
+#define _AT_REACTOR_H_
+
+#include "at.h"
+#include "list.h"
+#include <stdbool.h>
+
+#ifndef AT_REACTOR_EVENTS
+#define AT_REACTOR_EVENTS       64                              /*epoll_waitദ¼*/
+#endif
+
+#define AT_REACTOR_WORK_POLL    10                              /*ҵģʽļ(ms)*/
+
+struct at_reactor;
+
+/*Ӧ(ɵṩ, ÿATһ) --------------------------------*/
+typedef struct {
+    struct list_head   node;                                    /**/
+    struct list_head   wnode;                                   /**/
+    struct at_reactor *r;
+    at_obj_t          *at;
+    int                fd;
+    unsigned char      active : 1;                              /*ڻ*/
+    unsigned char      paused : 1;                              /*ҵģʽ, ͣ*/
+    unsigned char      hangup : 1;                              /*豸Ҷϻ(Ƴepoll)*/
+    unsigned char      woken  : 1;                              /*ڻ*/
+}at_reactor_item_t;
+
+/*Ӧ ---------------------------------------------------------------------*/
+typedef struct at_reactor {
+    int                epfd;
+    int                tfd;                                     /*ʱʱ(timerfd)*/
+    int                efd;                                     /*¼(eventfd)*/
+    at_sem_t           wlock;                                   /**/
+    struct list_head   woken;                                   /*̻߳ѵĶ*/
+    struct list_head   active;                                  /*дⳬʱĶ*/
+    unsigned int       due;                                     /*ʱʱ(ms)*/
+    unsigned char      armed;                                   /*ʱ*/
+    unsigned short     count;                                   /**/
+    /*ͳ -------------------------------------------------------------------*/
+    unsigned int       wakeups;                                 /*epoll_waitش*/
+    unsigned int       timer_fires;                             /*ʱڴ*/
+}at_reactor_t;
+
+bool at_reactor_init(at_reactor_t *r);
+
+void at_reactor_deinit(at_reactor_t *r);
+
+bool at_reactor_add(at_reactor_t *r, at_reactor_item_t *it, at_obj_t *at, int fd);
+
+void at_reactor_del(at_reactor_t *r, at_reactor_item_t *it);
+
+int at_reactor_poll(at_reactor_t *r, int timeout);
+
+void at_reactor_run(at_reactor_t *r);                          /*Ӧѭ*/
+
+#endif
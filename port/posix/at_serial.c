@@ -0,0 +1,184 @@
+/******************************************************************************
+ * @brief        POSIX(termios), Ϊat_conf_t/at_obj_conf_tṩдӿ
+ *
+ * Copyright (c) 2020, <morro_luo@163.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Morro        Initial version.
+ ******************************************************************************/
+
+#define _DEFAULT_SOURCE
+
+#include "at_serial.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdint.h>
+#include <sys/eventfd.h>
+#include <termios.h>
+#include <unistd.h>
+
+/*
+ * @brief       ת
+ * @return      B0 - ֵ֧Ĳ
+ */
+static speed_t baud_to_speed(unsigned int baud)
+{
+    switch (baud) {
+    case 9600:    return B9600;
+    case 19200:   return B19200;
+    case 38400:   return B38400;
+    case 57600:   return B57600;
+    case 115200:  return B115200;
+    case 230400:  return B230400;
+#ifdef B460800
+    case 460800:  return B460800;
+#endif
+#ifdef B921600
+    case 921600:  return B921600;
+#endif
+    default:      return B0;
+    }
+}
+
+/*
+ * @brief       򿪴(8N1, ԭʼģʽ, )
+ * @param[in]   dev  - 豸("/dev/ttyUSB2")
+ * @param[in]   conf - 
+ * @return      false - 򿪻ʧ(errnoָʾԭ)
+ */
+bool at_serial_open(at_serial_t *s, const char *dev, const at_serial_conf_t *conf)
+{
+    struct termios tio;
+    speed_t speed = baud_to_speed(conf->baud);
+    s->fd     = -1;
+    s->efd    = -1;
+    s->hangup = 0;
+    if (speed == B0) {
+        errno = EINVAL;
+        return false;
+    }
+    s->fd = open(dev, O_RDWR | O_NOCTTY | (conf->nonblock ? O_NONBLOCK : 0));
+    if (s->fd < 0)
+        return false;
+    if (tcgetattr(s->fd, &tio) != 0)
+        goto fail;
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cflag &= ~CRTSCTS;
+    tio.c_cc[VMIN]  = conf->vmin;
+    tio.c_cc[VTIME] = conf->vtime;
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    if (tcsetattr(s->fd, TCSANOW, &tio) != 0)
+        goto fail;
+    tcflush(s->fd, TCIOFLUSH);
+    s->efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);           /*ʧʱֻ֧*/
+    return true;
+fail:
+    close(s->fd);
+    s->fd = -1;
+    return false;
+}
+
+/*
+ * @brief       رմ
+ */
+void at_serial_close(at_serial_t *s)
+{
+    if (s->fd >= 0)
+        close(s->fd);
+    if (s->efd >= 0)
+        close(s->efd);
+    s->fd  = -1;
+    s->efd = -1;
+}
+
+/*
+ * @brief       ʹеat_serial_read_wait(Ӧcfg.read_wake, ̵߳)
+ */
+void at_serial_wake(at_serial_t *s)
+{
+    uint64_t v = 1;
+    if (s->efd >= 0)
+        (void)!write(s->efd, &v, sizeof(v));
+}
+
+/*
+ * @brief       (Ӧcfg.read)
+ * @return      ȡֽ, ݻʱ0(EIOʱλs->hangup)
+ */
+unsigned int at_serial_read(at_serial_t *s, void *buf, unsigned int len)
+{
+    ssize_t n;
+    while ((n = read(s->fd, buf, len)) < 0 && errno == EINTR) {}
+    if (n < 0 && errno == EIO)
+        s->hangup = 1;
+    return n > 0 ? (unsigned int)n : 0;
+}
+
+/*
+ * @brief       ȴݲȡ(Ӧat.ccfg.read_wait)
+ * @param[in]   timeout - ȴʱ(ms)
+ * @return      ȡֽ, ʱat_serial_wakeʱ0
+ * @note        豸ϿpollPOLLHUP/POLLERR, read0EIO, ʱλ
+ *              s->hangup, ֻ֮ȴѻʱ, ߳̿ת
+ */
+unsigned int at_serial_read_wait(at_serial_t *s, void *buf, unsigned int len,
+                                 unsigned int timeout)
+{
+    struct pollfd pfd[2] = {{s->hangup ? -1 : s->fd, POLLIN, 0}, {s->efd, POLLIN, 0}};
+    uint64_t v;
+    bool hup;
+    int ret;
+    while ((ret = poll(pfd, 2, (int)timeout)) < 0 && errno == EINTR) {}
+    if (ret <= 0)
+        return 0;
+    if (pfd[1].revents & POLLIN) {                              /*at_serial_wake*/
+        (void)!read(s->efd, &v, sizeof(v));
+        return 0;
+    }
+    if (pfd[0].revents & POLLIN) {
+        while ((ret = read(s->fd, buf, len)) < 0 && errno == EINTR) {}
+        if (ret > 0)
+            return ret;
+        hup = ret == 0 || errno == EIO;                         /*ɶ: ԶѶϿ*/
+    } else {
+        hup = (pfd[0].revents & (POLLHUP | POLLERR | POLLNVAL)) != 0;
+    }
+    if (hup) {
+        s->hangup = 1;
+        return at_serial_read_wait(s, buf, len, timeout);      /*ֻȴѻʱ*/
+    }
+    return 0;
+}
+
+/*
+ * @brief       д(Ӧcfg.write)
+ * @details     ģʽ·ͻʱȴд, ֤д
+ * @return      дֽ
+ */
+unsigned int at_serial_write(at_serial_t *s, const void *buf, unsigned int len)
+{
+    const unsigned char *p = (const unsigned char *)buf;
+    struct pollfd pfd = {s->fd, POLLOUT, 0};
+    unsigned int sent = 0;
+    ssize_t n;
+    while (sent < len) {
+        n = write(s->fd, p + sent, len - sent);
+        if (n > 0) {
+            sent += n;
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            if (poll(&pfd, 1, 1000) <= 0)                       /*1sڲдΪʧ*/
+                break;
+        } else {
+            break;
+        }
+    }
+    return sent;
+}
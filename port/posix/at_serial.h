@@ -0,0 +1,61 @@
+/******************************************************************************
+ * @brief        POSIX(termios), Ϊat_conf_t/at_obj_conf_tṩдӿ
+ *
+ * ʹʾ(дӿûĲ, ÿڰװһ麯):
+ *   static at_serial_t modem;
+ *   static unsigned int modem_read(void *buf, unsigned int len)
+ *   {
+ *       return at_serial_read(&modem, buf, len);
+ *   }
+ *   ...
+ *   static void modem_wake(void)                              //cfg.read_wake
+ *   {
+ *       at_serial_wake(&modem);
+ *   }
+ *   ...
+ *   at_serial_conf_t sc = {115200, 0, 0, 1};
+ *   at_serial_open(&modem, "/dev/ttyUSB2", &sc);
+ *
+ * Copyright (c) 2020, <morro_luo@163.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Morro        Initial version.
+ ******************************************************************************/
+
+#ifndef _AT_SERIAL_H_
+#define _AT_SERIAL_H_
+
+#include <stdbool.h>
+
+/* -------------------------------------------------------------------*/
+typedef struct {
+    unsigned int   baud;                                        /**/
+    unsigned char  vmin;                                        /*ֽ(VMIN)*/
+    unsigned char  vtime;                                       /*ֽڼ䳬ʱ(VTIME, 0.1s)*/
+    unsigned char  nonblock;                                    /*(VMIN/VTIME)*/
+}at_serial_conf_t;
+
+/* -----------------------------------------------------------------------*/
+typedef struct {
+    int            fd;
+    int            efd;                                         /*eventfd*/
+    unsigned char  hangup;                                      /*豸ѶϿ(USBγ), رպ´*/
+}at_serial_t;
+
+bool at_serial_open(at_serial_t *s, const char *dev, const at_serial_conf_t *conf);
+
+void at_serial_close(at_serial_t *s);
+
+unsigned int at_serial_read(at_serial_t *s, void *buf, unsigned int len);
+
+unsigned int at_serial_read_wait(at_serial_t *s, void *buf, unsigned int len,
+                                 unsigned int timeout);
+
+unsigned int at_serial_write(at_serial_t *s, const void *buf, unsigned int len);
+
+void at_serial_wake(at_serial_t *s);
+
+#endif
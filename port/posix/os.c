@@ -0,0 +1,114 @@
+/******************************************************************************
+ * @brief        atģOSӿPOSIXʵ(Linux, ʱ-Iport/posix)
+ *
+ * Copyright (c) 2020, <morro_luo@163.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Morro        Initial version.
+ ******************************************************************************/
+
+#define _GNU_SOURCE                                             /*sem_clockwait*/
+
+#include "os.h"
+#include <errno.h>
+#include <time.h>
+
+/*źȴʱ(glibc 2.30֧sem_clockwaitʱӵȴ) ---------------*/
+#if defined(__GLIBC_PREREQ)
+#if __GLIBC_PREREQ(2, 30)
+#define OS_SEM_CLOCKWAIT
+#endif
+#endif
+
+#ifdef OS_SEM_CLOCKWAIT
+#define OS_SEM_CLOCK    CLOCK_MONOTONIC
+#else
+#define OS_SEM_CLOCK    CLOCK_REALTIME
+#endif
+
+/*
+ * @brief       ȡʱӺ
+ */
+unsigned int ril_get_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned int)(ts.tv_sec * 1000ull + ts.tv_nsec / 1000000);
+}
+
+/*
+ * @brief       ȡʱ΢
+ */
+unsigned int ril_get_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned int)(ts.tv_sec * 1000000ull + ts.tv_nsec / 1000);
+}
+
+/*
+ * @brief       ʱ(źжʱʱʣʱ)
+ */
+void os_delay(uint32_t ms)
+{
+    struct timespec ts = {ms / 1000, (long)(ms % 1000) * 1000000L};
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {}
+}
+
+/*
+ * @brief       ʼź(̼߳ʹ)
+ */
+void os_sem_init(struct os_semaphore *s, int value)
+{
+    sem_init(&s->sem, 0, value);
+}
+
+/*
+ * @brief       ȡź
+ * @param[in]   timeout - ʱʱ(ms), 0 - ȴ
+ * @return      true - ȡɹ, false - ʱ
+ * @note        glibc 2.30ʹsem_clockwait(CLOCK_MONOTONIC), ϵͳʱ
+ *              ޸Ӱ; ʹsem_timedwait(CLOCK_REALTIMEʱ), ϵͳʱ
+ *              ޸ʱȴʱӦ仯
+ */
+bool os_sem_wait(struct os_semaphore *s, uint32_t timeout)
+{
+    struct timespec ts;
+    int ret;
+    if (timeout == 0) {
+        while ((ret = sem_trywait(&s->sem)) != 0 && errno == EINTR) {}
+        return ret == 0;
+    }
+    clock_gettime(OS_SEM_CLOCK, &ts);
+    ts.tv_sec  += timeout / 1000;
+    ts.tv_nsec += (long)(timeout % 1000) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+#ifdef OS_SEM_CLOCKWAIT
+    while ((ret = sem_clockwait(&s->sem, OS_SEM_CLOCK, &ts)) != 0 && errno == EINTR) {}
+#else
+    while ((ret = sem_timedwait(&s->sem, &ts)) != 0 && errno == EINTR) {}
+#endif
+    return ret == 0;
+}
+
+/*
+ * @brief       ͷź
+ */
+void os_sem_post(struct os_semaphore *s)
+{
+    sem_post(&s->sem);
+}
+
+/*
+ * @brief       ź
+ */
+void os_sem_destroy(struct os_semaphore *s)
+{
+    sem_destroy(&s->sem);
+}
@@ -0,0 +1,41 @@
+/******************************************************************************
+ * @brief        atģOSӿPOSIXʵ(Linux, ʱ-Iport/posix)
+ *
+ * Copyright (c) 2020, <morro_luo@163.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Morro        Initial version.
+ ******************************************************************************/
+
+#ifndef _POSIX_OS_H_
+#define _POSIX_OS_H_
+
+#include <semaphore.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define AT_USE_US_CLOCK                                         /*ṩ΢ʱ*/
+
+/*ź ---------------------------------------------------------------------*/
+struct os_semaphore {
+    sem_t sem;
+};
+
+unsigned int ril_get_ms(void);                                  /*ʱ(ms)*/
+
+unsigned int ril_get_us(void);                                  /*ʱ(us)*/
+
+void os_delay(uint32_t ms);
+
+void os_sem_init(struct os_semaphore *s, int value);
+
+bool os_sem_wait(struct os_semaphore *s, uint32_t timeout);
+
+void os_sem_post(struct os_semaphore *s);
+
+void os_sem_destroy(struct os_semaphore *s);
+
+#endif